@@ -0,0 +1,32 @@
+// AudioConfig.h — спільні параметри аудіоконвеєра (однакові для ESP32 і для native-збірки)
+#ifndef AUDIO_CONFIG_H
+#define AUDIO_CONFIG_H
+
+#ifndef SAMPLES
+#define SAMPLES 128 // кількість зразків для FFT (128 точок даних для аналізу сигналу)
+#endif
+#ifndef SAMPLING_FREQ
+#define SAMPLING_FREQ 10000 // частота дискретизації (10 кГц), тобто 10 000 зразків за секунду
+#endif
+
+// Тип обчислень FFT (задається прапорцем збірки, наприклад build_flags = -D SPECTRUM_TYPE=float):
+//   double (за замовчуванням), float, int16_t (Q15), int32_t (Q31) — див. RealFft.h
+#ifndef SPECTRUM_TYPE
+#define SPECTRUM_TYPE double
+#endif
+
+// Низькочастотна гілка (див. Decimator.h): зразки проріджуються в LOW_BAND_DECIMATION разів
+// і аналізуються окремим FFT на LOW_BAND_SAMPLES точок — біни по ~20 Гц замість ~78 Гц
+#ifndef LOW_BAND_DECIMATION
+#define LOW_BAND_DECIMATION 8
+#endif
+#define LOW_BAND_SAMPLES 64                                // 64 зразки по 0.8 мс = вікно 51 мс
+#define LOW_BAND_RATE (SAMPLING_FREQ / LOW_BAND_DECIMATION) // 1250 Гц
+#define LOW_BAND_TAPS 96                                   // довжина ФНЧ перед проріджуванням
+#define LOW_BAND_CUTOFF_HZ (LOW_BAND_RATE * 0.44)          // зріз ФНЧ (550 Гц), трохи нижче нової частоти Найквіста
+#define LOW_BAND_CROSSOVER_HZ (LOW_BAND_RATE * 0.32)       // нижче (400 Гц) діапазони беруться з низькочастотного FFT
+
+#define ADC_MAX 4095 // верхня межа 12-бітного АЦП ESP32 (0–4095)
+#define ADC_MID 2048 // середина діапазону АЦП, підставляється замість аномального першого зразка
+
+#endif
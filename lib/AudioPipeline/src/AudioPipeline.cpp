@@ -0,0 +1,328 @@
+#include "AudioPipeline.h"
+
+#include "Profiler.h"
+
+#include <math.h>
+
+// Амплітуда i-го біна повного спектра (0..SAMPLES-1): біни вище SAMPLES/2 — дзеркальні
+// копії нижніх (для дійсного сигналу |X[N-k]| = |X[k]|), тому беремо їх із неповторної половини
+static inline double mirroredBin(const double *bins, int i) { return bins[i <= SAMPLES / 2 ? i : SAMPLES - i]; }
+
+namespace tables {
+
+// 1 / |H(k)| для IIR-фільтра H(z) = IIR_INPUT / (1 - IIR_FEEDBACK * z^-1) на частоті біна k:
+// |1 - a*e^(-jω)| = sqrt(1 - 2a*cos(ω) + a^2), ω = 2πk / SAMPLES
+constexpr std::array<double, SPECTRUM_BINS> makeIirInverse() {
+  std::array<double, SPECTRUM_BINS> table{};
+  for (int k = 0; k < SPECTRUM_BINS; k++)
+    table[k] = squareRoot(1 - 2 * IIR_FEEDBACK * cosine(2 * kPi * k / SAMPLES) + IIR_FEEDBACK * IIR_FEEDBACK) / IIR_INPUT;
+  return table;
+}
+
+} // namespace tables
+
+static constexpr std::array<double, SPECTRUM_BINS> iirInverse = tables::makeIirInverse();
+
+AudioPipeline::AudioPipeline() : lowHead(0), lowFilled(0), lowValid(false), layout(0), timeEnergy(0), rawDeviation(0), count(0), smoothingFrames(SMOOTHING_FRAMES), feat() {
+  setThresholds(THRESHOLD_R, THRESHOLD_G, THRESHOLD_B);
+  setFeatures(FEATURE_ALL);
+}
+
+void AudioPipeline::setSmoothing(int frames) {
+  smoothingFrames = frames < 1 ? 1 : frames > SMOOTHING_MAX ? SMOOTHING_MAX : frames;
+  if (count > smoothingFrames) count = smoothingFrames; // коротше вікно — одразу, довше — набирається поступово
+}
+
+void AudioPipeline::setThresholds(double r, double g, double b) {
+  thresholds[0] = r;
+  thresholds[1] = g;
+  thresholds[2] = b;
+}
+
+// Рівні діапазонів out, нормалізовані за енергією сигналу і помножені на підсилення діапазону
+static void normalise(const BandMap &map, double avgEnergy, double *out) {
+  if (avgEnergy > 0)
+    for (int b = 0; b < map.count(); b++) out[b] = out[b] / avgEnergy * map.gain(b);
+}
+
+static void normalisedBands(const BandMap &map, const double *bins, const double *lowBins, double avgEnergy, double *out) {
+  map.apply(bins, out, lowBins);
+  normalise(map, avgEnergy, out);
+}
+
+static void setAmps(AudioFeatures &out) { // R, G, B — найнижчий, середній і найвищий діапазони
+  out.ampR = out.bands[0];
+  out.ampG = out.bands[out.bandCount / 2];
+  out.ampB = out.bands[out.bandCount - 1];
+}
+
+static double spectrumEnergy(const double *bins) { // середня амплітуда повного спектра (SAMPLES бінів)
+  double totalEnergy = 0;
+  for (int i = 0; i < SAMPLES; i++) {
+    double amplitude = mirroredBin(bins, i);
+    totalEnergy += amplitude * amplitude;
+  }
+  return sqrt(totalEnergy / SAMPLES);
+}
+
+void AudioPipeline::setFeatures(unsigned flags) {
+  required = flags;
+  if (flags & FEATURE_BANDS) method = SPECTRUM_FFT;
+  else if (flags & FEATURE_BAND_LEVEL) // Герцель вигідніший за FFT лише для кількох бінів (див. Goertzel.h)
+    method = bands.usedBinCount() <= GOERTZEL_MAX_BINS ? SPECTRUM_GOERTZEL : SPECTRUM_FFT;
+  else method = SPECTRUM_NONE;
+  layout = bands.revision();
+}
+
+void AudioPipeline::syncLayout() {
+  if (layout != bands.revision()) setFeatures(required);
+}
+
+const AudioFeatures &AudioPipeline::process(const int *samples, int newSamples) {
+  preprocess(samples, newSamples);
+  computeSpectrum();
+  computeBands();
+  smooth();
+  return feat;
+}
+
+void AudioPipeline::preprocess(const int *samples, int newSamples) {
+  PROFILE_SCOPE(PROFILE_PREPROCESS);
+  syncLayout();
+  // 1) Збір зразків (зчитані з мікрофона) + 2) корекція аномалій за межами діапазону АЦП ESP32 (0–4095):
+  // такий зразок замінюється попереднім або 2048 (ADC_MID), якщо він перший у кадрі.
+  /*
+    Чому значення може бути поза межами 0 - 4095:
+      1) шум - мікрофон або АЦП можуть видавати аномальні значення через
+    електричні перешкоди. 2) помилки АЦП - апаратні збої можуть призводити
+    до некоректних даних. Теоретично analogRead не повинен повертати < 0 або
+    > 4095, але код додає захист від таких випадків.
+  */
+  // 3) Видалення DC: віднімання середнього для усунення постійної складової (DC offset).
+  // 4) Фільтрація: IIR-фільтр для згладжування - простий рекурсивний фільтр: 70% попереднього значення + 30% поточного
+  /*
+    IIR — Infinite Impulse Response (нескінченна імпульсна характеристика) —
+    тип цифрового фільтра, який використовує попередні вихідні значення для
+    обчислення нового. Це рекурсивний фільтр: 70% попереднього значення + 30%
+    поточного. Він згладжує сигнал, зменшуючи різкі стрибки. На відміну від
+    FIR (Finite Impulse Response), який працює лише з вхідними даними, IIR
+    "пам’ятає" попередні результати, що робить його ефективнішим для
+    згладжування. Коефіцієнти (0.7 і 0.3) визначають "силу" згладжування (сума
+    = 1 для стабільності). Переваги: простота реалізації і низьке споживання
+    ресурсів.
+  */
+  // Усі чотири кроки — одним ядром preprocessFrame (Preprocess.h) прямо в arena.vReal.
+  //
+  // Низькочастотна гілка: нові зразки кадру (після корекції, до видалення DC) — через ФНЧ із
+  // проріджуванням у кільце lowRing. Кожен зразок звуку проходить через фільтр рівно один раз, навіть
+  // коли кадри перекриваються. Режимам без точних діапазонів вона не потрібна: кільце просто заповниться
+  // знову (~51 мс). "Сирі" дані (mode 4) рахуються з samples, без копії кадру
+  bool low = method == SPECTRUM_FFT;
+  bool raw = required & FEATURE_RAW;
+  int firstNew = SAMPLES - newSamples;
+  double rawSum = 0;
+  preprocessFrame(samples, arena.vReal, SAMPLES, [&](int i, int sample, int corrected) {
+    if (raw) rawSum += sample;
+    double decimated;
+    if (low && i >= firstNew && arena.decimator.push(corrected - ADC_MID, decimated)) {
+      arena.lowRing[lowHead] = decimated;
+      lowHead = (lowHead + 1) % LOW_BAND_SAMPLES;
+      if (lowFilled < LOW_BAND_SAMPLES) lowFilled++;
+    }
+  });
+  if (!low) lowFilled = 0;
+
+  rawDeviation = 0;
+  if (raw) {
+    double rawMean = rawSum / SAMPLES; // Середнє значення сирих даних
+    for (int i = 0; i < SAMPLES; i++) rawDeviation += fabs(samples[i] - rawMean); // Абсолютна різниця від середнього
+    rawDeviation /= SAMPLES; // Середня амплітуда відхилення
+  }
+}
+
+void AudioPipeline::computeSpectrum() {
+  // 5) FFT: перетворення в частотну область (windowing, FFT дійсного сигналу) - виконуємо
+  // послідовно дві процедури Fast Fourier Transform, FFT:
+  {
+    PROFILE_SCOPE(PROFILE_WINDOW);
+    applyWindow<SAMPLES, SPECTRUM_WINDOW>(arena.vReal); // Функція для зменшення впливу країв сигналу
+  }
+  /*
+    Коли ми беремо скінченний набір зразків сигналу (наприклад, 128 зразків із
+    частотою 10 кГц, як у нас), ми фактично "вирізаємо" шматок із
+    безперервного сигналу. Цей процес обрізання називається truncation, і він
+    створює проблему: краї обрізаного сигналу (початок і кінець) стають
+    різкими перепадами (discontinuities), навіть якщо оригінальний сигнал був
+    плавним (наприклад, синусоїда). Ці різкі перепади призводять до появи
+    спектральних витоків (spectral leakage) у частотній області після FFT.
+    Спектральні витоки — це коли енергія однієї частоти "розмазується" на
+    сусідні частоти, спотворюючи результат аналізу спектра. Віконне зважування
+    вирішує цю проблему, згладжуючи краї сигналу перед FFT: 1) множить кожен
+    зразок сигналу на певну вагу, яка залежить від його позиції у наборі
+    даних. 2) зазвичай ваги на краях (біля 0 і 127, як у нас) близькі до 0, а
+    в центрі (біля 64) — максимальні.
+
+    Використовуємо одну з популярних віконних функцій - вікно Хеммінга
+    (WINDOW_HAMMING). До віконування масив vReal містить "сирі" зразки з
+    мікрофона, наприклад: [100, 102, 105, ..., 98]. Після віконування кожен
+    елемент vReal[i] множиться на відповідне значення вікна Хеммінга: vReal[0]
+    = vReal[0] * 0.08 (зменшується). vReal[63] = vReal[63] * 1.0 (залишається
+    майже без змін). vReal[127] = vReal[127] * 0.08 (зменшується). Результат:
+      Сигнал стає плавнішим на краях, що зменшує різкі перепади.
+      Зменшується вплив країв сигналу - без віконування обрізаний сигнал
+    виглядає як прямокутник (усі зразки мають однакову вагу), що додає
+    високочастотні артефакти в спектр.
+
+    Вікно Хеммінга "згладжує" краї, роблячи сигнал схожим на дзвін, що знижує
+    ці артефакти. Хоча вікно трохи розширює основну частотну складову (main
+    lobe), воно значно зменшує бічні піки (side lobes), що робить спектр
+    чіткішим. Додається точність аналізу - це важливо для коректного розподілу
+    частот на світлодіоди (низькі, середні, високі), щоб шум від різких країв
+    не спотворював результат.
+
+    SpectrumTables.h підтримує й інші вікна (ті самі, що й бібліотека arduinoFFT):
+      1) WINDOW_RECTANGLE (без зважування, прямокутне вікно — найгірше
+    для витоків). 2) WINDOW_HANN (вікно Ханна — схоже на Хеммінга, але з
+    іншими характеристиками). 3) WINDOW_BLACKMAN (ще сильніше придушення
+    бічних піків). Хеммінг — хороший компроміс між роздільністю і придушенням
+    витоків.
+
+    Ваги вікна залежать лише від SAMPLES і типу вікна, тому їх один раз обчислює
+    компілятор (constexpr-таблиця у флеш-пам’яті), а не cos() на кожному кадрі —
+    під час роботи віконування зводиться до 128 множень.
+  */
+
+  if (method == SPECTRUM_FFT) {
+    PROFILE_SCOPE(PROFILE_FFT);
+    arena.realFft.magnitudes(arena.vReal, arena.bins); // 6) перетворення сигналу в частотну область і обчислення амплітуд
+  }
+  lowValid = method == SPECTRUM_FFT && lowFilled == LOW_BAND_SAMPLES;
+  if (lowValid) computeLowSpectrum();
+  /*
+    Виконує швидке перетворення Фур’є (FFT), перетворюючи сигнал із часової
+    області (зразки з мікрофона) у частотну область (амплітуди частот). Сигнал
+    мікрофона дійсний (уявна частина = 0), тому його спектр симетричний:
+    |X[k]| = |X[SAMPLES-k]|, і неповторних лише SAMPLES/2+1 = 65 бінів.
+    Замість повного комплексного FFT на 128 точок (з масивом уявних частин,
+    заповненим нулями) 128 дійсних зразків пакуються у 64 комплексні (парні ->
+    реальна частина, непарні -> уявна), рахується FFT на 64 точки, а окремий
+    прохід розділяє результат у 65 амплітуд. Це приблизно вдвічі дешевше.
+  */
+
+  if (method == SPECTRUM_GOERTZEL) { // розкладка займає кілька бінів: рахуємо лише їх (computeBands — applyUsed)
+    PROFILE_SCOPE(PROFILE_GOERTZEL);
+    Goertzel<SAMPLES, SPECTRUM_TYPE>::magnitudes(arena.vReal, bands.usedBins(), bands.usedBinCount(), arena.goertzelAmplitudes);
+  }
+  if (method != SPECTRUM_FFT) {
+    // Енергія без FFT — за теоремою Парсеваля: сума |X[k]|^2 по всіх SAMPLES бінах дорівнює
+    // SAMPLES * сума x[n]^2, тож sqrt(totalEnergy / SAMPLES) = sqrt(сума x[n]^2) по віконованих зразках
+    double sum = 0;
+    for (int i = 0; i < SAMPLES; i++) sum += arena.vReal[i] * arena.vReal[i];
+    timeEnergy = sqrt(sum);
+  }
+}
+
+void AudioPipeline::computeLowSpectrum() {
+  PROFILE_SCOPE(PROFILE_LOW_FFT);
+  // Біни по 128 зразках мають ширину ~78 Гц — усі баси в одному-двох бінах. Проріджені в
+  // LOW_BAND_DECIMATION разів зразки (частоти до LOW_BAND_CUTOFF_HZ) аналізуються окремим FFT:
+  // LOW_BAND_SAMPLES точок охоплюють у LOW_BAND_DECIMATION * LOW_BAND_SAMPLES / SAMPLES разів довший
+  // відрізок звуку, тож біни відповідно вужчі — без FFT на 1024 точки
+  double mean = 0;
+  for (int i = 0; i < LOW_BAND_SAMPLES; i++) {
+    arena.lowReal[i] = arena.lowRing[(lowHead + i) % LOW_BAND_SAMPLES]; // від найстарішого до найновішого
+    mean += arena.lowReal[i];
+  }
+  mean /= LOW_BAND_SAMPLES;
+  for (int i = 0; i < LOW_BAND_SAMPLES; i++) arena.lowReal[i] -= mean;
+  applyWindow<LOW_BAND_SAMPLES, SPECTRUM_WINDOW>(arena.lowReal);
+  arena.lowFft.magnitudes(arena.lowReal, arena.lowBins);
+  // Амплітуда синусоїди в біні пропорційна кількості точок FFT — приводимо до шкали основного FFT
+  for (int k = 0; k < LOW_BAND_BINS; k++) arena.lowBins[k] *= (double)SAMPLES / LOW_BAND_SAMPLES;
+}
+
+void AudioPipeline::computeBands() {
+  PROFILE_SCOPE(PROFILE_BANDS);
+  if (method == SPECTRUM_FFT) bandsFromSpectrum(arena.bins, feat, lowSpectrum());
+  else if (method == SPECTRUM_GOERTZEL) { // ті самі taps, але з амплітуд лише використаних бінів
+    feat.avgEnergy = timeEnergy;
+    feat.bandCount = bands.count();
+    bands.applyUsed(arena.goertzelAmplitudes, feat.bands);
+    normalise(bands, timeEnergy, feat.bands);
+    setAmps(feat);
+  } else { // режиму потрібна лише енергія (або нічого)
+    feat.bandCount = bands.count();
+    for (int b = 0; b < feat.bandCount; b++) feat.bands[b] = 0;
+    feat.ampR = feat.ampG = feat.ampB = 0;
+    feat.avgEnergy = timeEnergy;
+  }
+}
+
+void AudioPipeline::bandsFromSpectrum(const double *bins, AudioFeatures &out, const double *lowBins) const {
+  // 8) Нормалізація: масштабування амплітуд за енергією сигналу.
+  // Енергія = сума квадратів амплітуд (усіх SAMPLES бінів, разом із дзеркальними)
+  bandsFromSpectrum(bins, spectrumEnergy(bins), out, lowBins);
+  /*
+    енергія = сума квадратів амплітуд бо енергія сигналу як фізична величина
+    - пропорційна квадрату амплітуди. Корінь із середньої суми квадратів
+    (sqrt(totalEnergy / SAMPLES)) дає середню амплітуду.
+  */
+}
+
+void AudioPipeline::bandsFromSpectrum(const double *bins, double avgEnergy, AudioFeatures &out, const double *lowBins) const {
+  // 7) Розподіл частот: кожен неповторний бін (0..SAMPLES/2) — у свій діапазон BandMap з вагою;
+  // дзеркальні біни SAMPLES/2+1..SAMPLES-1 — ті самі частоти, тому в діапазони не потрапляють
+  out.avgEnergy = avgEnergy;
+  out.bandCount = bands.count();
+  normalisedBands(bands, bins, lowBins, avgEnergy, out.bands);
+  setAmps(out);
+  /*
+    нормалізація - приведення даних до певного масштабу (наприклад, відносно
+    середнього значення або енергії). Зменшує вплив фонового шуму, але
+    конкретні коефіцієнти залежать від конкретного мікрофона і середовища
+    роботи.
+  */
+  /*
+    Підсилюємо амплітуди - вирішуємо проблему різної гучності: тихий сигнал не
+    "гасить" світлодіоди, а гучний не перевантажує їх Після нормалізації
+    амплітуди можуть бути замалими для світлодіодів (0–255). Множники
+    діапазонів (BandMap::gain: GAIN_LOW, GAIN_MID, GAIN_HIGH для найнижчого, середнього і найвищого)
+    масштабують їх до видимого діапазону.
+  */
+}
+
+void AudioPipeline::smooth() {
+  PROFILE_SCOPE(PROFILE_SMOOTH);
+  // 9) Ковзне середнє: згладжування значень амплітуд із часом - усереднюємо амплітуди для плавної зміни кольорів
+  feat.avgAmpR = (feat.avgAmpR * count + feat.ampR) / (count + 1);
+  feat.avgAmpG = (feat.avgAmpG * count + feat.ampG) / (count + 1);
+  feat.avgAmpB = (feat.avgAmpB * count + feat.ampB) / (count + 1);
+  count++;
+  if (count > smoothingFrames) count = smoothingFrames;
+
+  //  пороги потрібні для реалізації конкретної ідеї світломузики на led-кружальці - для визначення кількості led які мають світитись
+  feat.porigR = feat.avgAmpR * thresholds[0];
+  feat.porigG = feat.avgAmpG * thresholds[1];
+  feat.porigB = feat.avgAmpB * thresholds[2];
+}
+
+BandAmps AudioPipeline::computeRawBands() const {
+  // "Сирі" дані відрізняються від основного шляху лише IIR-фільтром (DC і вікно — ті самі), а IIR —
+  // лінійний фільтр з відомою АЧХ: спектр фільтрованого сигналу = |H(k)| * спектр сирого. Тож сирий
+  // спектр отримуємо з уже порахованого bins множенням на 1/|H(k)| (constexpr-таблиця), без копії
+  // даних, ще одного віконування і другого FFT. Наближення: віконування після фільтра і перехідний
+  // процес на початку кадру трохи "розмивають" АЧХ (похибку діапазонів перевіряє test_spectrum)
+  double *rawBins = arena.rawBins;
+  for (int k = 0; k < SPECTRUM_BINS; k++) rawBins[k] = arena.bins[k] * iirInverse[k];
+
+  // Розподіл частот і нормалізація за енергією — та сама розкладка діапазонів
+  double *level = arena.rawLevels;
+  normalisedBands(bands, rawBins, nullptr, spectrumEnergy(rawBins), level);
+  BandAmps raw = {level[0], level[bands.count() / 2], level[bands.count() - 1]};
+  return raw;
+}
+
+double AudioPipeline::rawAmplitude() const {
+  // Спрощена обробка "сирих" даних: середнє відхилення від середнього (рахується в preprocess)
+  return rawDeviation;
+}
@@ -0,0 +1,155 @@
+// AudioPipeline.h — апаратно-незалежний ланцюжок обробки звуку:
+// зразки -> корекція аномалій -> видалення DC -> IIR -> FFT -> діапазони (BandMap) -> ковзне середнє.
+// Не залежить від analogRead, FastLED чи FreeRTOS, тому збирається і на ESP32, і на ПК (env:native).
+#ifndef AUDIO_PIPELINE_H
+#define AUDIO_PIPELINE_H
+
+#include "AudioConfig.h"
+#include "BandMap.h"
+#include "Decimator.h"
+#include "Goertzel.h"
+#include "Preprocess.h"
+#include "RealFft.h"
+#include "SlidingWindow.h"
+#include "SpectrumTables.h"
+
+#define SPECTRUM_BINS (SAMPLES / 2 + 1) // неповторні біни спектра дійсного сигналу (0..SAMPLES/2)
+#define SPECTRUM_WINDOW WINDOW_HAMMING  // вікно перед FFT (таблиця ваг обчислюється компілятором)
+#define LOW_BAND_BINS (LOW_BAND_SAMPLES / 2 + 1) // біни низькочастотного FFT (по LOW_BAND_RATE / LOW_BAND_SAMPLES Гц)
+
+#define SMOOTHING_FRAMES 50 // крок 9: кадрів у ковзному середньому амплітуд (за замовчуванням)
+#define SMOOTHING_MAX 500
+#define THRESHOLD_R 0.8 // пороги = ковзне середнє * множник (для кількості LED, що світяться)
+#define THRESHOLD_G 1.2
+#define THRESHOLD_B 0.8
+
+enum FeatureFlags { // які ознаки звуку потрібні активному режиму — від цього залежить, що саме рахувати
+  FEATURE_ENERGY = 1 << 0,     // avgEnergy (за теоремою Парсеваля — без FFT)
+  FEATURE_BANDS = 1 << 1,      // точні діапазони (bands, ampR/ampG/ampB) — потрібні всі біни, тобто FFT
+  FEATURE_BAND_LEVEL = 1 << 2, // рівні діапазонів: розкладка до GOERTZEL_MAX_BINS бінів — Герцелем (без низькочастотного FFT), інакше як FEATURE_BANDS
+  FEATURE_RAW = 1 << 3,        // "сирі" дані (mode 4, 5) — рахуються окремо через rawAmplitude/computeRawBands (без FFT)
+  FEATURE_ALL = FEATURE_ENERGY | FEATURE_BANDS,
+};
+
+enum SpectrumMethod { // як computeSpectrum отримує спектр (обирається автоматично з FeatureFlags)
+  SPECTRUM_NONE,      // спектр не потрібен (енергія — з часової області)
+  SPECTRUM_GOERTZEL,  // лише потрібні біни алгоритмом Герцеля
+  SPECTRUM_FFT,       // усі біни через FFT дійсного сигналу
+};
+
+struct AudioFeatures { // результат обробки одного кадру (те, що потрібно режимам світломузики)
+  double bands[MAX_BANDS];          // рівні діапазонів BandMap після нормалізації (від низьких до високих)
+  int bandCount;
+  int ampR, ampG, ampB;             // найнижчий (R), середній (G) і найвищий (B) із bands
+  double avgEnergy;                 // середня енергія спектра
+  double avgAmpR, avgAmpG, avgAmpB; // ковзні середні амплітуд між кадрами
+  int porigR, porigG, porigB;       // пороги для визначення кількості LED, що світяться
+};
+
+struct BandAmps { // амплітуди трьох діапазонів без згладжування (для "сирих" даних у mode 5)
+  double r, g, b;
+};
+
+struct FeatureFrame { // усе, що потрібно режиму для одного кадру світлодіодів (передається між задачами)
+  AudioFeatures features;
+  double rawAmplitude; // mode 4
+  BandAmps raw;        // mode 5
+  int mode;            // режим, для якого рахувались ознаки
+  uint32_t sequence;   // номер кадру аналізу (пропуски — кадри, які не встигли показати)
+};
+
+// Усі робочі буфери аналізу — один вирівняний блок усередині AudioPipeline: кадр і спектри, робочі
+// масиви обох FFT (re/im), історія ФНЧ проріджування, а також буфери збору кадру задачі аналізу
+// (ковзне вікно, block, frame). Конвеєр — глобальний об’єкт, тож арена лежить у статичній пам’яті
+// (.bss): розмір перевіряється під час компіляції, а стек задачі аналізу не тримає масивів кадру.
+// Поза ареною — лише налаштування і таблиці розкладки (BandMap), ознаки й лічильники. Розміри після збірки
+// прошивки друкує tools/size_report.py (символ pipeline), а sizeof(DspArena) — бенчмарк і Serial під час старту
+#define DSP_ALIGN 16              // вирівнювання кожного буфера (рядок кешу / векторні завантаження)
+#define DSP_ARENA_MAX_BYTES 10240 // бюджет арени: перевіряється static_assert нижче
+
+struct DspArena {
+  // обчислювальні блоки з власними робочими масивами (re/im FFT, history ФНЧ)
+  alignas(DSP_ALIGN) RealFft<SAMPLES, SPECTRUM_TYPE> realFft;           // FFT дійсного сигналу: лише SPECTRUM_BINS неповторних бінів
+  alignas(DSP_ALIGN) RealFft<LOW_BAND_SAMPLES, SPECTRUM_TYPE> lowFft;   // FFT проріджених зразків (баси з вищою роздільністю)
+  alignas(DSP_ALIGN) Decimator<LOW_BAND_DECIMATION, LOW_BAND_TAPS, (int)LOW_BAND_CUTOFF_HZ, SAMPLING_FREQ> decimator;
+  // збір кадру (заповнює задача аналізу, див. workspace())
+  alignas(DSP_ALIGN) SlidingWindow window; // ковзне вікно: останні SAMPLES зразків, новий кадр кожні hop зразків
+  alignas(DSP_ALIGN) int block[SAMPLES];   // нові зразки за один крок (hop)
+  alignas(DSP_ALIGN) int frame[SAMPLES];   // вікно з SAMPLES зразків для аналізу
+  // дані кадру
+  alignas(DSP_ALIGN) double vReal[SAMPLES];            // зразки сигналу (дійсні — уявна частина не потрібна)
+  alignas(DSP_ALIGN) double bins[SPECTRUM_BINS];       // амплітуди спектра
+  alignas(DSP_ALIGN) double lowRing[LOW_BAND_SAMPLES]; // кільце проріджених зразків
+  alignas(DSP_ALIGN) double lowReal[LOW_BAND_SAMPLES]; // вікно низькочастотного FFT
+  alignas(DSP_ALIGN) double lowBins[LOW_BAND_BINS];    // амплітуди низькочастотного FFT
+  // тимчасові дані окремих кроків (раніше — масиви на стеку задачі)
+  alignas(DSP_ALIGN) double rawBins[SPECTRUM_BINS]; // computeRawBands: спектр без IIR
+  double rawLevels[MAX_BANDS];
+  double goertzelAmplitudes[GOERTZEL_MAX_BINS]; // амплітуди BandMap::usedBins() (SPECTRUM_GOERTZEL)
+};
+
+static_assert(sizeof(DspArena) <= DSP_ARENA_MAX_BYTES, "буфери конвеєра не вміщаються в DSP_ARENA_MAX_BYTES");
+
+class AudioPipeline {
+public:
+  AudioPipeline();
+
+  // Увесь ланцюжок за один виклик (кроки 1–9). newSamples — скільки останніх зразків кадру нові
+  // (крок ковзного вікна): лише вони потрапляють у низькочастотну гілку
+  const AudioFeatures &process(const int *samples, int newSamples = SAMPLES);
+
+  // Які ознаки потрібні (FeatureFlags); за замовчуванням — усі. Від цього залежить спосіб
+  // обчислення спектра: без спектра, Герцель для кількох бінів або повне FFT. Для FEATURE_BAND_LEVEL
+  // він залежить і від розкладки діапазонів, тож після зміни bandMap() обирається заново на наступному кадрі
+  void setFeatures(unsigned flags);
+  SpectrumMethod spectrumMethod() const { return method; }
+
+  // Окремі кроки — щоб між ними можна було вивести налагоджувальні дані або заміряти час
+  void preprocess(const int *samples, int newSamples = SAMPLES); // 1-4) корекція аномалій, DC, IIR, проріджування
+  void computeSpectrum();             // 5-6) windowing, FFT дійсного сигналу (і низькочастотне FFT), амплітуди
+  void computeBands();                // 7-8) розподіл частот і нормалізація
+  void smooth();                      // 9) ковзне середнє і пороги
+
+  // Кроки 7-8 для готового спектра: заповнює bands, ampR/ampG/ampB і avgEnergy у out;
+  // lowBins — LOW_BAND_BINS амплітуд низькочастотного FFT (якщо є — для частот нижче LOW_BAND_CROSSOVER_HZ)
+  void bandsFromSpectrum(const double *bins, AudioFeatures &out, const double *lowBins = nullptr) const;
+  void bandsFromSpectrum(const double *bins, double avgEnergy, AudioFeatures &out, const double *lowBins = nullptr) const;
+
+  // Розкладка діапазонів (за замовчуванням — BAND_COUNT логарифмічних між BAND_MIN_HZ і BAND_MAX_HZ)
+  BandMap &bandMap() { return bands; }
+
+  // Крок 9: довжина ковзного середнього (1..SMOOTHING_MAX кадрів) і множники порогів porigR/G/B
+  void setSmoothing(int frames);
+  void setThresholds(double r, double g, double b);
+
+  // Той самий аналіз для "сирих" даних без IIR (mode 5) — без другого FFT: спектр відновлюється зі
+  // spectrum() діленням на АЧХ IIR-фільтра, тож викликати після computeSpectrum зі SPECTRUM_FFT
+  BandAmps computeRawBands() const;
+  double rawAmplitude() const; // середнє відхилення "сирих" даних від середнього (mode 4, без FFT; лише з FEATURE_RAW)
+
+  const AudioFeatures &features() const { return feat; }
+  const double *timeDomain() const { return arena.vReal; } // зразки сигналу (після preprocess — відфільтровані, після computeSpectrum — ще й віконовані)
+  const double *spectrum() const { return arena.bins; } // SPECTRUM_BINS амплітуд після computeSpectrum зі SPECTRUM_FFT
+  const double *lowSpectrum() const { return lowValid ? arena.lowBins : nullptr; } // LOW_BAND_BINS амплітуд (nullptr — ще немає)
+  DspArena &workspace() { return arena; } // буфери збору кадру (window, block, frame) — для задачі аналізу
+
+private:
+  void computeLowSpectrum(); // FFT проріджених зразків у lowBins
+  void syncLayout();         // розкладку bandMap() змінено — заново обрати спосіб обчислення спектра
+
+  BandMap bands;                // біни -> діапазони
+  mutable DspArena arena; // усі робочі буфери; mutable — computeRawBands (const) пише в тимчасові
+  int lowHead, lowFilled; // кільце проріджених зразків arena.lowRing
+  bool lowValid; // lowBins обчислені для поточного кадру
+  unsigned required;       // FeatureFlags активного режиму
+  uint32_t layout;         // BandMap::revision(), для якої обрано method
+  SpectrumMethod method;   // спосіб обчислення спектра для них
+  double timeEnergy;       // avgEnergy з часової області (для SPECTRUM_NONE і SPECTRUM_GOERTZEL)
+  double rawDeviation;     // rawAmplitude поточного кадру
+  int count; // кількість кадрів у ковзному середньому (не більше smoothingFrames)
+  int smoothingFrames;
+  double thresholds[3]; // множники порогів R, G, B
+  AudioFeatures feat;
+};
+
+#endif
@@ -0,0 +1,43 @@
+// Backoff.h — експоненційна затримка між повторними спробами (підключення до Wi-Fi).
+// Перша повторна спроба — через BACKOFF_INITIAL_MS після старту, кожна наступна — удвічі пізніше,
+// але не рідше ніж раз на BACKOFF_MAX_MS: точка доступу, що довго недоступна, не забирає ефір і час
+// ядра спробами кожні кілька секунд, а після її появи плата підключиться щонайпізніше за хвилину.
+// Час — мілісекунди від будь-якого годинника (millis() на ESP32, фіктивний — у тесті test_backoff).
+#ifndef BACKOFF_H
+#define BACKOFF_H
+
+#include <stdint.h>
+
+#define BACKOFF_INITIAL_MS 4000 // одна спроба підключення зазвичай триває 1–3 с
+#define BACKOFF_MAX_MS 60000
+
+class Backoff {
+public:
+  Backoff(uint32_t initialMs = BACKOFF_INITIAL_MS, uint32_t maxMs = BACKOFF_MAX_MS)
+      : initial(initialMs), limit(maxMs), delay(initialMs), last(0), count(0) {}
+
+  void start(uint32_t nowMs) { // спроба щойно почалась (або зв’язок щойно втрачено): відлік заново
+    delay = initial;
+    last = nowMs;
+    count = 0;
+  }
+
+  bool due(uint32_t nowMs) const { return nowMs - last >= delay; } // час повторної спроби
+
+  void attempt(uint32_t nowMs) { // повторна спроба почалась — наступна вдвічі пізніше
+    last = nowMs;
+    delay = delay >= limit / 2 ? limit : delay * 2;
+    count++;
+  }
+
+  uint32_t delayMs() const { return delay; } // до наступної спроби від останньої
+  uint32_t attempts() const { return count; } // повторних спроб від start()
+
+private:
+  uint32_t initial, limit;
+  uint32_t delay;
+  uint32_t last;
+  uint32_t count;
+};
+
+#endif
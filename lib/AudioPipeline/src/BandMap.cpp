@@ -0,0 +1,100 @@
+#include "BandMap.h"
+
+#include <math.h>
+
+static double hzToMel(double hz) { return 2595 * log10(1 + hz / 700); }
+static double melToHz(double mel) { return 700 * (pow(10, mel / 2595) - 1); }
+
+BandMap::BandMap() : tapCount(0), fusedCount(0), bandCount(0), usedCount(0), builds(0) {
+  build(BAND_SCALE, BAND_COUNT, BAND_MIN_HZ, BAND_MAX_HZ);
+}
+
+bool BandMap::build(BandScale scale, int bands, double minHz, double maxHz) {
+  if (bands < 1 || bands > MAX_BANDS || minHz <= 0 || maxHz <= minHz) return false;
+  double edgesHz[MAX_BANDS + 1];
+  for (int b = 0; b <= bands; b++) {
+    double t = (double)b / bands;
+    if (scale == BAND_SCALE_MEL) edgesHz[b] = melToHz(hzToMel(minHz) + t * (hzToMel(maxHz) - hzToMel(minHz)));
+    else edgesHz[b] = minHz * pow(maxHz / minHz, t);
+  }
+  return build(edgesHz, bands);
+}
+
+bool BandMap::build(const double *edgesHz, int bands) {
+  if (bands < 1 || bands > MAX_BANDS) return false;
+  for (int b = 0; b < bands; b++)
+    if (edgesHz[b] < 0 || edgesHz[b + 1] <= edgesHz[b]) return false;
+
+  const double binHz = (double)SAMPLING_FREQ / SAMPLES; // ширина біна
+  if (edgesHz[bands - 1] >= (SAMPLES / 2 + 0.5) * binHz) return false; // діапазон вище частоти Найквіста — жодного біна
+
+  tapCount = buildTaps(edgesHz, bands, 0, taps);
+  fusedCount = buildTaps(edgesHz, bands, LOW_BAND_CROSSOVER_HZ, fusedTaps);
+  bandCount = bands;
+  for (int b = 0; b <= bands; b++) edges[b] = edgesHz[b];
+  defaultGains(bands, gains);
+
+  // Біни taps ідуть за діапазонами, а в діапазоні — за зростанням; сусідні діапазони ділять лише
+  // бін на межі, тож уся послідовність неспадна і повтори — поспіль
+  usedCount = 0;
+  for (int t = 0; t < tapCount; t++) {
+    if (usedCount == 0 || used[usedCount - 1] != taps[t].bin) used[usedCount++] = taps[t].bin;
+    taps[t].slot = usedCount - 1;
+  }
+  builds++;
+  return true;
+}
+
+void BandMap::defaultGains(int bands, double *out) {
+  for (int b = 0; b < MAX_BANDS; b++) out[b] = GAIN_DEFAULT;
+  out[0] = GAIN_LOW;
+  out[bands / 2] = GAIN_MID;
+  out[bands - 1] = GAIN_HIGH;
+}
+
+// Ваги бінів для кожного діапазону; частоти нижче crossoverHz — з бінів низькочастотного FFT
+int BandMap::buildTaps(const double *edgesHz, int bands, double crossoverHz, Tap *out) {
+  const double binHz[2] = {(double)SAMPLING_FREQ / SAMPLES, (double)LOW_BAND_RATE / LOW_BAND_SAMPLES}; // ширина біна
+  const int lastBin[2] = {SAMPLES / 2, LOW_BAND_SAMPLES / 2};
+  int count = 0;
+  for (int b = 0; b < bands; b++) {
+    int first = count;
+    double total = 0;
+    for (int low = 0; low < 2; low++) {
+      // Повне FFT — частоти від crossoverHz, низькочастотне — до crossoverHz
+      double from = low ? edgesHz[b] : fmax(edgesHz[b], crossoverHz);
+      double to = low ? fmin(edgesHz[b + 1], crossoverHz) : edgesHz[b + 1];
+      for (int i = 0; i <= lastBin[low]; i++) {
+        // Бін i покриває частоти [i - 0.5, i + 0.5] * binHz; його вага в діапазоні — частка перекриття
+        double lo = fmax((i - 0.5) * binHz[low], from), hi = fmin((i + 0.5) * binHz[low], to);
+        if (hi <= lo) continue;
+        out[count].bin = i;
+        out[count].band = b;
+        out[count].low = low;
+        out[count].slot = 0;
+        out[count].weight = (hi - lo) / binHz[low];
+        total += out[count].weight;
+        count++;
+      }
+    }
+    for (int t = first; t < count; t++) out[t].weight /= total; // середнє, а не сума: ширина діапазону не впливає на рівень
+  }
+  return count;
+}
+
+void BandMap::apply(const double *bins, double *bands, const double *lowBins) const {
+  for (int b = 0; b < bandCount; b++) bands[b] = 0;
+  if (!lowBins) {
+    for (int t = 0; t < tapCount; t++) bands[taps[t].band] += taps[t].weight * bins[taps[t].bin];
+    return;
+  }
+  for (int t = 0; t < fusedCount; t++) {
+    const Tap &tap = fusedTaps[t];
+    bands[tap.band] += tap.weight * (tap.low ? lowBins : bins)[tap.bin];
+  }
+}
+
+void BandMap::applyUsed(const double *amplitudes, double *bands) const {
+  for (int b = 0; b < bandCount; b++) bands[b] = 0;
+  for (int t = 0; t < tapCount; t++) bands[taps[t].band] += taps[t].weight * amplitudes[taps[t].slot];
+}
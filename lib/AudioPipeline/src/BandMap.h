@@ -0,0 +1,101 @@
+// BandMap.h — таблиця розподілу бінів спектра по частотних діапазонах.
+// Межі діапазонів задаються в герцах (логарифмічні, мел-шкала або власні), а таблиця один раз
+// (під час запуску) перераховує їх у ваги бінів: бін, що лежить на межі, ділиться між сусідніми
+// діапазонами пропорційно перекриттю. Враховуються лише неповторні біни 0..SAMPLES/2 — дзеркальні
+// біни дійсного сигналу несуть ті самі частоти і не повинні потрапляти у "високі".
+// Частоти нижче LOW_BAND_CROSSOVER_HZ можна брати з низькочастотного FFT (див. Decimator.h) —
+// там біни у LOW_BAND_DECIMATION * LOW_BAND_SAMPLES / SAMPLES разів вужчі.
+#ifndef BAND_MAP_H
+#define BAND_MAP_H
+
+#include "AudioConfig.h"
+
+#include <stdint.h>
+
+#define MAX_BANDS 16 // найбільша кількість діапазонів
+
+// Розкладка за замовчуванням (прапорцями збірки, наприклад -D BAND_COUNT=8 -D BAND_SCALE=BAND_SCALE_MEL)
+#ifndef BAND_COUNT
+#define BAND_COUNT 3 // баси (R), середні (G), високі (B)
+#endif
+#ifndef BAND_SCALE
+#define BAND_SCALE BAND_SCALE_LOG
+#endif
+#ifndef BAND_MIN_HZ
+#define BAND_MIN_HZ 40 // нижче — лише залишки DC і гул мережі
+#endif
+#ifndef BAND_MAX_HZ
+#define BAND_MAX_HZ (SAMPLING_FREQ / 2) // частота Найквіста
+#endif
+
+// Підсилення за замовчуванням (BandMap::defaultGains): найнижчий, середній (count/2) і найвищий діапазони —
+// ті, що стають ampR, ampG і ampB; решта — GAIN_DEFAULT
+#define GAIN_LOW 150
+#define GAIN_MID 100
+#define GAIN_HIGH 150
+#define GAIN_DEFAULT 100
+
+enum BandScale {
+  BAND_SCALE_LOG, // рівні відношення сусідніх меж (сталий Q: кожен діапазон — однакова кількість октав)
+  BAND_SCALE_MEL, // рівні кроки за мел-шкалою (ближче до сприйняття висоти звуку)
+};
+
+class BandMap {
+public:
+  BandMap();
+
+  // Будує таблицю для bands діапазонів між minHz і maxHz; false — якщо параметри неприпустимі.
+  // Успішний build скидає підсилення до defaultGains: старі належали іншим діапазонам
+  bool build(BandScale scale, int bands, double minHz, double maxHz);
+  // Власні межі: edgesHz — bands+1 зростаючих частот
+  bool build(const double *edgesHz, int bands);
+
+  // Середня амплітуда кожного діапазону (зважена) з SAMPLES/2+1 амплітуд спектра; якщо є lowBins
+  // (LOW_BAND_SAMPLES/2+1 амплітуд низькочастотного FFT), частоти нижче LOW_BAND_CROSSOVER_HZ — з них
+  void apply(const double *bins, double *bands, const double *lowBins = nullptr) const;
+
+  // Біни повного FFT, з яких складаються діапазони (зростаючі, без повторів): коли їх небагато, їх можна
+  // порахувати алгоритмом Герцеля, а не все FFT. applyUsed — те саме, що apply без lowBins, але з
+  // амплітуд лише цих бінів (amplitudes[j] — амплітуда біна usedBins()[j])
+  int usedBinCount() const { return usedCount; }
+  const int *usedBins() const { return used; }
+  void applyUsed(const double *amplitudes, double *bands) const;
+
+  // Номер розкладки: зростає з кожним успішним build — власник за ним помічає, що розкладку змінено
+  uint32_t revision() const { return builds; }
+
+  int count() const { return bandCount; }
+  double lowHz(int band) const { return edges[band]; }
+  double highHz(int band) const { return edges[band + 1]; }
+
+  void setGain(int band, double value) { gains[band] = value; } // множник після нормалізації за енергією
+  double gain(int band) const { return gains[band]; }
+  static void defaultGains(int bands, double *out); // MAX_BANDS підсилень для розкладки з bands діапазонів
+
+private:
+  struct Tap { // внесок одного біна в один діапазон
+    uint8_t bin;
+    uint8_t band;
+    uint8_t low;  // 1 — бін низькочастотного FFT
+    uint8_t slot; // номер біна в used (лише taps повного FFT)
+    float weight; // частка біна в діапазоні, поділена на суму часток діапазону
+  };
+
+  // Кожен бін — в одному діапазоні, крім бінів на межах (і на LOW_BAND_CROSSOVER_HZ)
+  static const int MAX_TAPS = SAMPLES / 2 + 1 + LOW_BAND_SAMPLES / 2 + 1 + MAX_BANDS + 1;
+
+  static int buildTaps(const double *edgesHz, int bands, double crossoverHz, Tap *out);
+
+  Tap taps[MAX_TAPS];      // лише повне FFT
+  Tap fusedTaps[MAX_TAPS]; // низькочастотне FFT нижче LOW_BAND_CROSSOVER_HZ + повне вище
+  int tapCount;
+  int fusedCount;
+  int bandCount;
+  int used[SAMPLES / 2 + 1]; // біни taps без повторів
+  int usedCount;
+  uint32_t builds;
+  double edges[MAX_BANDS + 1];
+  double gains[MAX_BANDS];
+};
+
+#endif
@@ -0,0 +1,59 @@
+// Decimator.h — проріджування сигналу в M разів із ФНЧ (КІХ-фільтр, вікно Хеммінга).
+// Звичайний КІХ-фільтр на TAPS коефіцієнтів, але згортка рахується лише для кожного M-го вхідного
+// зразка (решта виходів однаково відкидаються проріджуванням); між ними зразок тільки записується в
+// історію. У середньому це TAPS/M множень на вхідний зразок замість TAPS — стільки ж, скільки в
+// поліфазній схемі. Фільтр лінійно-фазовий (h[j] = h[TAPS-1-j]), тож симетричні зразки спершу
+// додаються — множень удвічі менше. Коефіцієнти обчислює компілятор (constexpr-таблиця у флеш-пам’яті).
+#ifndef DECIMATOR_H
+#define DECIMATOR_H
+
+#include "SpectrumTables.h"
+
+namespace tables {
+
+constexpr double lowPassTap(int n, int taps, double cutoff) { // cutoff — частка частоти дискретизації
+  double m = n - (taps - 1) / 2.0;
+  double ideal = m == 0 ? 2 * cutoff : sine(2 * kPi * cutoff * m) / (kPi * m); // sinc — ідеальний ФНЧ
+  return ideal * windowWeight(WINDOW_HAMMING, n, taps);
+}
+
+template <int TAPS> constexpr std::array<double, TAPS> makeLowPass(double cutoff) {
+  std::array<double, TAPS> table{};
+  double sum = 0;
+  for (int n = 0; n < TAPS; n++) sum += lowPassTap(n, TAPS, cutoff);
+  for (int n = 0; n < TAPS; n++) table[n] = lowPassTap(n, TAPS, cutoff) / sum; // підсилення на 0 Гц = 1
+  return table;
+}
+
+} // namespace tables
+
+template <int M, int TAPS, int CUTOFF_HZ, int RATE> class Decimator {
+  static_assert(TAPS % 2 == 0, "симетрична згортка розрахована на парну кількість коефіцієнтів");
+
+public:
+  Decimator() : head(0), phase(0) {
+    for (int i = 0; i < 2 * TAPS; i++) history[i] = 0;
+  }
+
+  // Додає вхідний зразок; повертає true і новий зразок у out на кожному M-му виклику
+  bool push(double x, double &out) {
+    head = head == 0 ? TAPS - 1 : head - 1;
+    history[head] = history[head + TAPS] = x; // подвійний запис: останні TAPS зразків завжди підряд
+    if (++phase < M) return false;
+    phase = 0;
+    const std::array<double, TAPS> &h = taps;
+    const double *recent = history + head; // recent[j] = x[n - j]
+    double sum = 0;
+    for (int j = 0; j < TAPS / 2; j++) sum += h[j] * (recent[j] + recent[TAPS - 1 - j]);
+    out = sum;
+    return true;
+  }
+
+private:
+  static constexpr std::array<double, TAPS> taps = tables::makeLowPass<TAPS>((double)CUTOFF_HZ / RATE);
+  double history[2 * TAPS];
+  int head;  // позиція найновішого зразка
+  int phase; // скільки вхідних зразків від останнього вихідного
+};
+
+#endif
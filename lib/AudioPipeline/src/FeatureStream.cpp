@@ -0,0 +1,77 @@
+#include "FeatureStream.h"
+
+#include <math.h>
+
+uint8_t FeatureStreamEncoder::quantise(double level) {
+  if (!(level > 0)) return 0; // також NaN
+  if (level >= STREAM_LEVEL_MAX) return 255;
+  return (uint8_t)lround(sqrt(level) * 8); // sqrt(1023) * 8 = 255.9
+}
+
+size_t FeatureStreamEncoder::encode(const FeatureFrame &frame, uint8_t *out) {
+  const AudioFeatures &f = frame.features;
+  int n = f.bandCount < 0 ? 0 : f.bandCount > MAX_BANDS ? MAX_BANDS : f.bandCount;
+  double energy = f.avgEnergy > 65535 ? 65535 : f.avgEnergy > 0 ? f.avgEnergy : 0;
+  uint16_t e = (uint16_t)lround(energy);
+  bool key = sinceKey >= STREAM_KEYFRAME_EVERY || n != lastCount;
+  uint8_t q[MAX_BANDS];
+  int changed = 0;
+  for (int b = 0; b < n; b++) {
+    q[b] = quantise(f.bands[b]);
+    if (!key && q[b] != last[b]) changed++;
+  }
+  if (9 + changed >= 7 + n) key = true; // при кількох діапазонах маска не окупається — повний кадр не довший
+
+  out[0] = key ? STREAM_KEY_FRAME : STREAM_DELTA_FRAME;
+  out[1] = (uint8_t)frame.mode;
+  out[2] = frame.sequence & 0xFF;
+  out[3] = (frame.sequence >> 8) & 0xFF;
+  out[4] = e & 0xFF;
+  out[5] = e >> 8;
+  out[6] = (uint8_t)n;
+  size_t size = 7;
+  if (key) {
+    for (int b = 0; b < n; b++) out[size++] = last[b] = q[b];
+    lastCount = n;
+    sinceKey = 1;
+    return size;
+  }
+  uint16_t mask = 0;
+  size = 9;
+  for (int b = 0; b < n; b++) {
+    if (q[b] == last[b]) continue;
+    mask |= 1u << b;
+    out[size++] = last[b] = q[b];
+  }
+  out[7] = mask & 0xFF;
+  out[8] = mask >> 8;
+  sinceKey++;
+  return size;
+}
+
+bool FeatureStreamDecoder::decode(const uint8_t *data, size_t size) {
+  if (size < 7 || data[6] > MAX_BANDS) return false;
+  int n = data[6];
+  if (data[0] == STREAM_KEY_FRAME) {
+    if (size != 7 + (size_t)n) return false;
+    for (int b = 0; b < n; b++) bands[b] = data[7 + b];
+    synced = true;
+  } else if (data[0] == STREAM_DELTA_FRAME) {
+    if (!synced || n != bandCount || size < 9) return false;
+    uint16_t mask = data[7] | (data[8] << 8);
+    size_t at = 9;
+    for (int b = 0; b < n; b++) {
+      if (!(mask & (1u << b))) continue;
+      if (at == size) return false;
+      bands[b] = data[at++];
+    }
+    if (at != size) return false;
+  } else {
+    return false;
+  }
+  bandCount = n;
+  mode = data[1];
+  sequence = data[2] | (data[3] << 8);
+  energy = data[4] | (data[5] << 8);
+  return true;
+}
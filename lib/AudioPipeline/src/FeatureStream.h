@@ -0,0 +1,73 @@
+// FeatureStream.h — стислі двійкові кадри ознак для трансляції через WebSocket (/ws).
+// Кожен клієнт має власний кодер: повний кадр (ключовий) лише на початку, після зміни кількості
+// діапазонів і раз на STREAM_KEYFRAME_EVERY кадрів, а між ними — лише діапазони, що змінились (якщо
+// так виходить коротше, ніж повний кадр).
+// Рівні квантовані в 1 байт (квадратний корінь: точніше на малих рівнях). Якщо клієнт не встигає,
+// кадр йому просто не надсилається — кодер не оновлюється, тож наступна різниця рахується від того,
+// що клієнт справді отримав.
+//
+// Формат (little-endian):
+//   0     тип: STREAM_KEY_FRAME або STREAM_DELTA_FRAME
+//   1     режим
+//   2–3   номер кадру аналізу (молодші 16 біт)
+//   4–5   avgEnergy (uint16, з насиченням)
+//   6     кількість діапазонів n
+//   ключовий: 7.. — n рівнів; різницевий: 7–8 — маска змінених діапазонів, далі їхні рівні по порядку
+#ifndef FEATURE_STREAM_H
+#define FEATURE_STREAM_H
+
+#include "AudioPipeline.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define STREAM_KEY_FRAME 1
+#define STREAM_DELTA_FRAME 2
+#define STREAM_KEYFRAME_EVERY 50         // повний кадр щонайменше раз на 50 надісланих
+#define STREAM_FRAME_MAX (9 + MAX_BANDS) // найдовший кадр у байтах
+#define STREAM_LEVEL_MAX 1023            // рівень діапазону, що квантується в 255 (вище — насичення)
+
+#define STREAM_FPS 10 // кадрів/с для нового клієнта (клієнт змінює надсиланням тексту "fps=N")
+#define STREAM_FPS_MIN 1
+#define STREAM_FPS_MAX 30
+
+static_assert(MAX_BANDS <= 16, "маска змінених діапазонів — 16 біт");
+
+class FeatureStreamEncoder {
+public:
+  FeatureStreamEncoder() : lastCount(-1) { reset(); }
+
+  void reset() { sinceKey = STREAM_KEYFRAME_EVERY; } // наступний кадр — ключовий (новий клієнт)
+
+  // Кодує кадр у out (щонайменше STREAM_FRAME_MAX байт), повертає довжину. Виклик означає, що кадр
+  // буде надіслано: наступний різницевий кадр рахується від нього
+  size_t encode(const FeatureFrame &frame, uint8_t *out);
+
+  static int clampFps(int fps) { return fps < STREAM_FPS_MIN ? STREAM_FPS_MIN : fps > STREAM_FPS_MAX ? STREAM_FPS_MAX : fps; }
+  static uint8_t quantise(double level);
+  static double dequantise(uint8_t q) { return (q / 8.0) * (q / 8.0); }
+
+private:
+  uint8_t last[MAX_BANDS]; // рівні, які клієнт уже отримав
+  int lastCount;
+  int sinceKey; // кадрів від останнього ключового
+};
+
+// Стан на боці клієнта (так само розбирає кадри сторінка index.html); на ПК — для перевірки кодера
+class FeatureStreamDecoder {
+public:
+  FeatureStreamDecoder() : bandCount(0), mode(0), sequence(0), energy(0), synced(false) {}
+
+  bool decode(const uint8_t *data, size_t size); // false — кадр пошкоджений або різниця до першого ключового
+
+  uint8_t bands[MAX_BANDS];
+  int bandCount;
+  int mode;
+  uint16_t sequence;
+  uint16_t energy;
+
+private:
+  bool synced; // уже був ключовий кадр
+};
+
+#endif
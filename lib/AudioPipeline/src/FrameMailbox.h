@@ -0,0 +1,42 @@
+// FrameMailbox.h — найсвіжіший кадр від однієї задачі до іншої, коли читачу потрібен лише останній
+// (задача світлодіодів показує найновіші ознаки, а не всі підряд). Писач кожним кадром замінює
+// попередній і ніколи не чекає; читач знімає узгоджену копію через seqlock (SeqLock.h).
+// На відміну від черги, комірка не переповнюється, хоч би як часто писали: кадр, замінений до того,
+// як його прочитали, не втрачено — його просто не було коли показати. Втраченим рахується лише кадр,
+// якого читач не зміг скопіювати за відведені спроби (писач весь час заважав).
+#ifndef FRAME_MAILBOX_H
+#define FRAME_MAILBOX_H
+
+#include "SeqLock.h"
+
+#include <stdint.h>
+
+template <typename T> class FrameMailbox {
+public:
+  FrameMailbox() : slot(T{}), seen(slot.writes()), lostCount(0) {}
+
+  void publish(const T &frame) { slot.store(frame); } // лише писач
+
+  // Лише читач: true — з’явився новий кадр і out — його копія; false — нового немає або копія не
+  // вдалась за attempts спроб (тоді lost() зростає, а кадр спробуємо взяти наступного разу)
+  bool take(T &out, int attempts) {
+    uint32_t written = slot.writes();
+    if (written == seen) return false;
+    if (!slot.tryLoad(out, attempts)) {
+      lostCount++;
+      return false;
+    }
+    seen = written; // копія не старша за written; якщо писач тим часом записав ще, наступний take візьме найновіший
+    return true;
+  }
+
+  uint32_t published() const { return slot.writes() - 1; } // кадрів від писача (перший запис — порожній кадр)
+  uint32_t lost() const { return lostCount; }               // лише читач
+
+private:
+  SeqLock<T> slot;
+  uint32_t seen;      // slot.writes() на момент останньої вдалої копії
+  uint32_t lostCount;
+};
+
+#endif
@@ -0,0 +1,48 @@
+#include "FrameScheduler.h"
+
+FrameScheduler::FrameScheduler(int fps)
+    : started(false), overran(false), deadline(0), startUs(0), workUs(0), frameCount(0), overrunCount(0), skipped(0), overrunStreak(0),
+      relaxedStreak(0), degradeLevel(0) {
+  setFps(fps);
+}
+
+void FrameScheduler::setFps(int fps) {
+  targetFps = clampFps(fps);
+  period = 1000000u / targetFps;
+}
+
+void FrameScheduler::frameStart(uint32_t nowUs) {
+  if (!started) { // перший кадр: відлік дедлайнів — від нього
+    started = true;
+    deadline = nowUs;
+  }
+  startUs = nowUs;
+}
+
+uint32_t FrameScheduler::frameEnd(uint32_t nowUs) {
+  workUs = nowUs - startUs;
+  frameCount++;
+  deadline += period; // дедлайн кадру — початок наступного періоду, а не "зараз + період"
+
+  int32_t slack = (int32_t)(deadline - nowUs);
+  overran = slack <= 0;
+  if (overran) { // не встигли: пропущені періоди відкидаємо, наступний кадр — на найближчому дедлайні
+    overrunCount++;
+    uint32_t missed = (uint32_t)(-slack) / period + 1;
+    skipped += missed - 1;
+    deadline += missed * period;
+    relaxedStreak = 0;
+    if (++overrunStreak >= DEGRADE_AFTER_OVERRUNS && degradeLevel < DEGRADE_MAX_LEVEL) {
+      degradeLevel++;
+      overrunStreak = 0;
+    }
+  } else {
+    overrunStreak = 0;
+    if (loadPercent() > RECOVER_LOAD_PERCENT) relaxedStreak = 0;
+    else if (++relaxedStreak >= RECOVER_AFTER_FRAMES && degradeLevel > 0) {
+      degradeLevel--;
+      relaxedStreak = 0;
+    }
+  }
+  return deadline - nowUs;
+}
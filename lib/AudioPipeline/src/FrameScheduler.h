@@ -0,0 +1,85 @@
+// FrameScheduler.h — темп кадрів світлодіодів за дедлайнами (як vTaskDelayUntil) замість фіксованої паузи.
+// Дедлайни рахуються від початку відліку з кроком у період кадру, тож час роботи кадру і затримки
+// планувальника не накопичуються: частота кадрів лишається заданою, скільки б не тривав кадр.
+// Кадр, що не встиг до свого дедлайну, — перевищення (overrun): пропущені періоди не "доганяються"
+// пачкою кадрів, а відкидаються. Якщо перевищення йдуть підряд, рівень деградації зростає
+// (задача аналізу рахує менше кадрів — див. AnalysisThrottle), а після тривалого запасу — знижується.
+// Не залежить від FreeRTOS: час передається ззовні (мкс), тож логіку можна перевірити з фіктивним годинником.
+#ifndef FRAME_SCHEDULER_H
+#define FRAME_SCHEDULER_H
+
+#include <stdint.h>
+
+#ifndef RENDER_FPS
+#define RENDER_FPS 20 // кадрів світлодіодів за секунду (50 мс на кадр)
+#endif
+#define RENDER_FPS_MIN 1
+#define RENDER_FPS_MAX 100
+
+#define DEGRADE_AFTER_OVERRUNS 3  // перевищень підряд, після яких рівень деградації зростає
+#define RECOVER_AFTER_FRAMES 100  // кадрів із запасом, після яких рівень знижується
+#define RECOVER_LOAD_PERCENT 50   // "запас" — кадр зайняв не більше цієї частки періоду
+#define DEGRADE_MAX_LEVEL 2
+
+class FrameScheduler {
+public:
+  explicit FrameScheduler(int fps = RENDER_FPS);
+
+  static int clampFps(int value) { return value < RENDER_FPS_MIN ? RENDER_FPS_MIN : (value > RENDER_FPS_MAX ? RENDER_FPS_MAX : value); }
+
+  void setFps(int fps); // новий період діє з наступного кадру
+  int fps() const { return targetFps; }
+  uint32_t periodUs() const { return period; }
+
+  void frameStart(uint32_t nowUs); // початок роботи кадру (перший виклик задає відлік дедлайнів)
+  // Кінець роботи кадру: повертає, скільки мкс спати до початку наступного кадру (його дедлайну)
+  uint32_t frameEnd(uint32_t nowUs);
+  bool lastOverrun() const { return overran; } // останній кадр не встиг до дедлайну
+
+  uint32_t frames() const { return frameCount; }
+  uint32_t overruns() const { return overrunCount; }     // кадрів, що не встигли до дедлайну
+  uint32_t skippedPeriods() const { return skipped; }    // періодів, відкинутих після перевищень
+  uint32_t lastWorkUs() const { return workUs; }         // тривалість роботи останнього кадру
+  int loadPercent() const { return period ? (int)(100ull * workUs / period) : 0; }
+  int level() const { return degradeLevel; }             // 0 — повна якість, DEGRADE_MAX_LEVEL — найдешевший режим
+
+private:
+  uint32_t period;
+  int targetFps;
+  bool started;
+  bool overran;
+  uint32_t deadline; // час наступного дедлайну (мкс; порівнюємо різницею — переповнення uint32 не заважає)
+  uint32_t startUs;
+  uint32_t workUs;
+  uint32_t frameCount, overrunCount, skipped;
+  int overrunStreak;  // перевищень підряд
+  int relaxedStreak;  // кадрів із запасом підряд
+  int degradeLevel;
+};
+
+// Дешевший аналіз за рівнем деградації: на рівні L рахується лише кожен 2^L-й крок hop. Зразки все
+// одно щокроку надходять у ковзне вікно, тож кадр, який аналізується, — повний і свіжий; менше лише
+// кадрів (FFT) на секунду звуку — незалежно від того, який крок hop задав користувач
+class AnalysisThrottle {
+public:
+  AnalysisThrottle() : steps(0), pending(0), fresh(0) {}
+
+  // Ще hop нових зразків у вікні; true — цей кадр треба аналізувати
+  bool step(int level, int hop) {
+    pending += hop;
+    if (++steps < (1 << level)) return false;
+    steps = 0;
+    fresh = pending;
+    pending = 0;
+    return true;
+  }
+
+  int newSamples() const { return fresh; } // нових зразків з попереднього проаналізованого кадру (для низькочастотної гілки)
+
+private:
+  int steps;   // кроків після останнього проаналізованого кадру
+  int pending; // зразків за ці кроки
+  int fresh;
+};
+
+#endif
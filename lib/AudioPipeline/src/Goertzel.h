@@ -0,0 +1,77 @@
+// Goertzel.h — обчислення окремих бінів спектра алгоритмом Герцеля (розріджене DFT).
+// Один бін коштує N множень-додавань, тоді як FFT рахує всі N/2+1 бінів приблизно за N/2*log2(N/2)
+// "метеликів". Тому Герцель вигідний, коли режиму потрібно лише кілька бінів (або жодного) —
+// точку перетину для конкретного процесора показує бенчмарк env:native.
+#ifndef GOERTZEL_H
+#define GOERTZEL_H
+
+#include "SpectrumTables.h"
+
+#include <math.h>
+#include <stdint.h>
+
+// Якщо потрібно не більше стількох бінів — рахуємо Герцелем, інакше повне FFT
+// (на ПК точка перетину — 4 біни для 128 зразків, див. бенчмарк)
+#ifndef GOERTZEL_MAX_BINS
+#define GOERTZEL_MAX_BINS 4
+#endif
+
+#define GOERTZEL_LANES 4 // скільки бінів рахується за один прохід по зразках
+
+template <typename T> struct GoertzelMath { typedef T value_t; };   // double і float — як є
+template <> struct GoertzelMath<int16_t> { typedef float value_t; }; // для Q15/Q31 рекурсія Герцеля
+template <> struct GoertzelMath<int32_t> { typedef float value_t; }; // нестійка, тому — апаратний float
+
+namespace tables {
+template <typename T, int N> constexpr std::array<T, N / 2 + 1> makeGoertzelCoeffs() { // 2cos(2πk/N)
+  std::array<T, N / 2 + 1> table{};
+  for (int k = 0; k <= N / 2; k++) table[k] = (T)(2 * cosine(2 * kPi * k / N));
+  return table;
+}
+} // namespace tables
+
+template <int N, typename T = double> class Goertzel {
+public:
+  typedef typename GoertzelMath<T>::value_t value_t;
+
+  // Амплітуда k-го біна (0..N/2) для N дійсних зразків — те саме значення, що дає FFT
+  static double magnitude(const double *x, int k) {
+    const value_t c = coeffs[k];
+    value_t s1 = 0, s2 = 0;
+    for (int n = 0; n < N; n++) {
+      value_t s = (value_t)x[n] + c * s1 - s2;
+      s2 = s1;
+      s1 = s;
+    }
+    value_t power = s1 * s1 + s2 * s2 - c * s1 * s2;
+    return power > 0 ? sqrt((double)power) : 0;
+  }
+
+  // Амплітуди кількох бінів за прохід: рекурсії різних бінів незалежні, тож по GOERTZEL_LANES
+  // бінів рахуються разом і процесор виконує їх паралельно, а зразок читається раз на групу
+  static void magnitudes(const double *x, const int *ks, int count, double *out) {
+    int i = 0;
+    for (; i + GOERTZEL_LANES <= count; i += GOERTZEL_LANES) {
+      value_t c[GOERTZEL_LANES], s1[GOERTZEL_LANES] = {}, s2[GOERTZEL_LANES] = {};
+      for (int l = 0; l < GOERTZEL_LANES; l++) c[l] = coeffs[ks[i + l]];
+      for (int n = 0; n < N; n++) {
+        const value_t v = (value_t)x[n];
+        for (int l = 0; l < GOERTZEL_LANES; l++) {
+          value_t s = v + c[l] * s1[l] - s2[l];
+          s2[l] = s1[l];
+          s1[l] = s;
+        }
+      }
+      for (int l = 0; l < GOERTZEL_LANES; l++) {
+        value_t power = s1[l] * s1[l] + s2[l] * s2[l] - c[l] * s1[l] * s2[l];
+        out[i + l] = power > 0 ? sqrt((double)power) : 0;
+      }
+    }
+    for (; i < count; i++) out[i] = magnitude(x, ks[i]);
+  }
+
+private:
+  static constexpr std::array<value_t, N / 2 + 1> coeffs = tables::makeGoertzelCoeffs<value_t, N>();
+};
+
+#endif
@@ -0,0 +1,63 @@
+// LedOutput.h — абстрактний вивід кадру на адресні стрічки (WS2812B).
+// Режими малюють у масиви пікселів, а реалізація лише передає їх по дроту: одночасно по апаратному
+// каналу на стрічку (RMT на ESP32), через FastLED або в макет на ПК, що рахує час передачі.
+// Не залежить від FastLED: піксель — 3 байти R, G, B (так само лежить у пам’яті CRGB).
+#ifndef LED_OUTPUT_H
+#define LED_OUTPUT_H
+
+#include <stdint.h>
+#include <string.h>
+
+#define LED_OUTPUT_MAX_STRIPS 8 // стрічок на контролер (на ESP32 — 8 каналів RMT)
+#define LED_STRIP_MAX_LEDS 64   // найдовша стрічка (буфер кадру виводу — на кожну стрічку)
+
+// Протокол WS2812B: 24 біти на LED по 1.25 мкс, після кадру — пауза скидання
+#define LED_BIT_NS 1250
+#define LED_RESET_US 280 // WS2812B V5 чекає щонайменше 280 мкс (старі версії — 50 мкс)
+
+struct LedStrip {
+  int pin;
+  uint8_t *pixels; // count пікселів по 3 байти (R, G, B)
+  int count;
+};
+
+class LedOutput {
+public:
+  LedOutput() : stripTotal(0), level(255) {}
+  virtual ~LedOutput() {}
+
+  // Додає стрічку (до begin); повертає її номер — біт у масці show — або -1, якщо каналів не лишилось
+  int addStrip(int pin, uint8_t *pixels, int count) {
+    if (stripTotal == LED_OUTPUT_MAX_STRIPS || count > LED_STRIP_MAX_LEDS) return -1;
+    strips[stripTotal] = LedStrip{pin, pixels, count};
+    return stripTotal++;
+  }
+
+  virtual bool begin() = 0; // налаштування каналів для доданих стрічок; false — якщо вивід недоступний
+
+  // Передає стрічки з маски (біт i — стрічка i) одночасно і повертається, коли передачу завершено.
+  // Стрічки поза маскою не передаються і світяться як раніше
+  virtual void show(uint32_t mask) = 0;
+  void showAll() { show(allStrips()); }
+
+  void clear() { // гасить усі пікселі в пам’яті (на стрічки — лише після show)
+    for (int i = 0; i < stripTotal; i++) memset(strips[i].pixels, 0, strips[i].count * 3);
+  }
+
+  void setBrightness(uint8_t value) { level = value; } // 0–255, множник кожного каналу під час виводу
+  uint8_t brightness() const { return level; }
+
+  int stripCount() const { return stripTotal; }
+  const LedStrip &strip(int i) const { return strips[i]; }
+  uint32_t allStrips() const { return stripTotal == 32 ? 0xFFFFFFFFu : (1u << stripTotal) - 1; }
+
+  static uint32_t wireTimeUs(int leds) { return (uint32_t)leds * 24 * LED_BIT_NS / 1000 + LED_RESET_US; }
+  static uint8_t scale(uint8_t value, uint8_t level) { return (value * (level + 1)) >> 8; } // як scale8 у FastLED
+
+protected:
+  LedStrip strips[LED_OUTPUT_MAX_STRIPS];
+  int stripTotal;
+  uint8_t level;
+};
+
+#endif
@@ -0,0 +1,148 @@
+#include "LightParams.h"
+
+#include "FrameScheduler.h"
+#include "SlidingWindow.h"
+
+#include <ctype.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+LightParams defaultLightParams() {
+  LightParams p;
+  p.version = 0;
+  p.mode = 2;
+  p.gainCount = BAND_COUNT;
+  BandMap::defaultGains(p.gainCount, p.gains); // як після BandMap::build
+  p.thresholds[0] = THRESHOLD_R;
+  p.thresholds[1] = THRESHOLD_G;
+  p.thresholds[2] = THRESHOLD_B;
+  p.smoothing = SMOOTHING_FRAMES;
+  p.brightness = LIGHT_BRIGHTNESS;
+  p.hop = SAMPLES;
+  p.fps = RENDER_FPS;
+  return p;
+}
+
+namespace {
+
+class JsonReader { // найпростіший розбір плаского JSON-об’єкта: ключі-рядки, значення — числа або масиви чисел
+public:
+  JsonReader(const char *text, size_t length) : at(text), end(text + length) {}
+
+  bool consume(char c) {
+    skipSpace();
+    if (at == end || *at != c) return false;
+    at++;
+    return true;
+  }
+  bool key(char *out, size_t size) { // "ключ" без екранування
+    if (!consume('"')) return false;
+    size_t n = 0;
+    while (at < end && *at != '"') {
+      if (*at == '\\' || n + 1 == size) return false;
+      out[n++] = *at++;
+    }
+    out[n] = 0;
+    return consume('"');
+  }
+  bool number(double &out) {
+    skipSpace();
+    char buffer[32];
+    size_t n = 0;
+    while (at < end && n + 1 < sizeof(buffer) && (isdigit((unsigned char)*at) || strchr("+-.eE", *at))) buffer[n++] = *at++;
+    buffer[n] = 0;
+    char *parsed;
+    out = strtod(buffer, &parsed);
+    return n > 0 && *parsed == 0;
+  }
+  int numbers(double *out, int max) { // масив [a, b, ...]; -1 — помилка або більше max значень
+    if (!consume('[')) return -1;
+    int n = 0;
+    if (consume(']')) return 0;
+    do {
+      if (n == max || !number(out[n++])) return -1;
+    } while (consume(','));
+    return consume(']') ? n : -1;
+  }
+  bool atEnd() {
+    skipSpace();
+    return at == end;
+  }
+
+private:
+  void skipSpace() {
+    while (at < end && isspace((unsigned char)*at)) at++;
+  }
+  const char *at, *end;
+};
+
+PatchResult fail(char *error, size_t size, const char *message, const char *key = "", PatchResult result = PATCH_INVALID) {
+  snprintf(error, size, "%s%s%s", message, *key ? ": " : "", key);
+  return result;
+}
+
+bool isInteger(double v) { return v == floor(v) && fabs(v) < 1e9; }
+
+} // namespace
+
+PatchResult patchLightParams(const char *json, size_t length, LightParams &params, char *error, size_t errorSize) {
+  LightParams p = params; // зміни — на копії: або всі поля, або жодного
+  JsonReader in(json, length);
+  if (!in.consume('{')) return fail(error, errorSize, "очікується JSON-об’єкт");
+  if (!in.consume('}')) {
+    do {
+      char key[16];
+      double v = 0;
+      if (!in.key(key, sizeof(key)) || !in.consume(':')) return fail(error, errorSize, "неправильний ключ");
+      if (!strcmp(key, "gains") || !strcmp(key, "thresholds")) {
+        bool gains = key[0] == 'g';
+        double values[MAX_BANDS];
+        int n = in.numbers(values, gains ? MAX_BANDS : 3);
+        if (n != (gains ? p.gainCount : 3)) return fail(error, errorSize, "неправильна кількість значень", key);
+        for (int i = 0; i < n; i++) {
+          if (!(values[i] >= 0 && values[i] <= (gains ? LIGHT_GAIN_MAX : LIGHT_THRESHOLD_MAX)))
+            return fail(error, errorSize, "значення поза межами", key);
+          (gains ? p.gains : p.thresholds)[i] = values[i];
+        }
+        continue;
+      }
+      if (!in.number(v) || !isInteger(v)) return fail(error, errorSize, "очікується ціле число", key);
+      if (!strcmp(key, "version")) {
+        if (v < 0) return fail(error, errorSize, "значення поза межами", key); // (uint32_t) від’ємного double — UB
+        if ((uint32_t)v != params.version) return fail(error, errorSize, "версія застаріла — стан уже змінено", "", PATCH_CONFLICT);
+      } else if (!strcmp(key, "mode")) {
+        if (v < 1 || v > 255) return fail(error, errorSize, "значення поза межами", key);
+        p.mode = v;
+      } else if (!strcmp(key, "smoothing")) {
+        if (v < 1 || v > SMOOTHING_MAX) return fail(error, errorSize, "значення поза межами", key);
+        p.smoothing = v;
+      } else if (!strcmp(key, "brightness")) {
+        if (v < 0 || v > 255) return fail(error, errorSize, "значення поза межами", key);
+        p.brightness = v;
+      } else if (!strcmp(key, "hop")) {
+        p.hop = SlidingWindow::clampHop(v);
+      } else if (!strcmp(key, "fps")) {
+        p.fps = FrameScheduler::clampFps(v);
+      } else {
+        return fail(error, errorSize, "невідомий параметр", key);
+      }
+    } while (in.consume(','));
+    if (!in.consume('}')) return fail(error, errorSize, "очікується , або }");
+  }
+  if (!in.atEnd()) return fail(error, errorSize, "зайві символи після об’єкта");
+  params = p;
+  return PATCH_OK;
+}
+
+size_t lightParamsToJson(const LightParams &p, char *out, size_t size) {
+  char gains[MAX_BANDS * 12] = "";
+  size_t n = 0;
+  for (int b = 0; b < p.gainCount && n < sizeof(gains); b++) n += snprintf(gains + n, sizeof(gains) - n, "%s%g", b ? "," : "", p.gains[b]);
+  return snprintf(out, size,
+                  "{\"version\":%u,\"mode\":%d,\"gains\":[%s],\"thresholds\":[%g,%g,%g],\"smoothing\":%d,\"brightness\":%d,"
+                  "\"hop\":%d,\"fps\":%d}",
+                  (unsigned)p.version, p.mode, gains, p.thresholds[0], p.thresholds[1], p.thresholds[2], p.smoothing,
+                  p.brightness, p.hop, p.fps);
+}
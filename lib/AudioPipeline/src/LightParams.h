@@ -0,0 +1,45 @@
+// LightParams.h — параметри світломузики, які можна змінювати без перепрошивки (/api/state).
+// Один блок з номером версії: веб-сервер змінює копію і публікує її цілою (ParamStore.h), а задачі
+// аналізу і світлодіодів застосовують нові значення, лише коли версія змінилась.
+// JSON — плаский об’єкт із числами і масивами чисел, без зовнішніх бібліотек:
+//   {"version":3,"mode":2,"gains":[150,100,150],"thresholds":[0.8,1.2,0.8],"smoothing":50,
+//    "brightness":100,"hop":128,"fps":20}
+#ifndef LIGHT_PARAMS_H
+#define LIGHT_PARAMS_H
+
+#include "AudioPipeline.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define LIGHT_GAIN_MAX 1000      // підсилення діапазону після нормалізації
+#define LIGHT_THRESHOLD_MAX 10.0 // множник порога від ковзного середнього
+#define LIGHT_BRIGHTNESS 100     // яскравість за замовчуванням (0–255)
+
+struct LightParams {
+  uint32_t version;           // зростає з кожною зміною (0 — ще не опубліковано)
+  int mode;                   // режим світломузики (номер у реєстрі Renderers.cpp)
+  int gainCount;              // скільки діапазонів мають власне підсилення (BandMap::count())
+  double gains[MAX_BANDS];    // підсилення діапазонів (BandMap::setGain)
+  double thresholds[3];       // множники порогів porigR/G/B
+  int smoothing;              // кадрів у ковзному середньому
+  int brightness;             // 0–255
+  int hop;                    // крок аналізу в зразках (SlidingWindow)
+  int fps;                    // кадрів світлодіодів за секунду (FrameScheduler)
+};
+
+LightParams defaultLightParams(); // значення, з якими прошивка працювала до /api/state
+
+enum PatchResult {
+  PATCH_OK,
+  PATCH_INVALID,  // неправильний JSON, невідомий параметр або значення поза межами
+  PATCH_CONFLICT, // "version" у JSON не збігається з params.version (хтось змінив стан раніше)
+};
+
+// Переносить у params поля з JSON-об’єкта (решта лишається як була). Діапазони значень перевіряються
+// (hop і fps — обмежуються, як у /hop і /fps); при помилці її текст — у error, а params не змінено
+PatchResult patchLightParams(const char *json, size_t length, LightParams &params, char *error, size_t errorSize);
+
+size_t lightParamsToJson(const LightParams &params, char *out, size_t size); // повертає довжину (як snprintf)
+
+#endif
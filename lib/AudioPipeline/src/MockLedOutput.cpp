@@ -0,0 +1,28 @@
+#include "MockLedOutput.h"
+
+MockLedOutput::MockLedOutput(bool parallel) : parallel(parallel), showCount(0), lastUs(0), totalUs(0) {
+  memset(stripSends, 0, sizeof(stripSends));
+  memset(frames, 0, sizeof(frames));
+}
+
+bool MockLedOutput::begin() { return true; }
+
+void MockLedOutput::show(uint32_t mask) {
+  uint32_t wire = 0;
+  for (int i = 0; i < stripTotal; i++) {
+    if (!(mask & (1u << i))) continue;
+    const LedStrip &s = strips[i];
+    for (int led = 0; led < s.count; led++) { // WS2812B чекає байти в порядку G, R, B
+      frames[i][3 * led] = scale(s.pixels[3 * led + 1], level);
+      frames[i][3 * led + 1] = scale(s.pixels[3 * led], level);
+      frames[i][3 * led + 2] = scale(s.pixels[3 * led + 2], level);
+    }
+    uint32_t us = wireTimeUs(s.count);
+    if (parallel) wire = us > wire ? us : wire; // канали працюють одночасно — чекаємо найдовшу стрічку
+    else wire += us;                            // стрічки по черзі — час додається
+    stripSends[i]++;
+  }
+  showCount++;
+  lastUs = wire;
+  totalUs += wire;
+}
@@ -0,0 +1,32 @@
+// MockLedOutput.h — макет виводу на стрічки для native-збірки: бенчмарку і тестів.
+// Нічого не передає, а запам’ятовує, що і коли було б передано: байти кожної стрічки (GRB, з
+// урахуванням яскравості) і час на дроті за протоколом WS2812B — для паралельного виводу (по каналу
+// на стрічку: час найдовшої) і для послідовного (як при виводі контролерів по черзі: сума).
+#ifndef MOCK_LED_OUTPUT_H
+#define MOCK_LED_OUTPUT_H
+
+#include "LedOutput.h"
+
+class MockLedOutput : public LedOutput {
+public:
+  explicit MockLedOutput(bool parallel = true);
+
+  bool begin() override;
+  void show(uint32_t mask) override;
+
+  uint32_t shows() const { return showCount; }
+  uint32_t lastWireUs() const { return lastUs; }                     // час передачі останнього кадру
+  uint64_t totalWireUs() const { return totalUs; }                   // сумарний час на дроті
+  uint32_t stripShows(int strip) const { return stripSends[strip]; } // скільки разів передано стрічку
+  const uint8_t *sent(int strip) const { return frames[strip]; }     // останні передані байти стрічки (GRB)
+
+private:
+  bool parallel;
+  uint32_t showCount;
+  uint32_t lastUs;
+  uint64_t totalUs;
+  uint32_t stripSends[LED_OUTPUT_MAX_STRIPS];
+  uint8_t frames[LED_OUTPUT_MAX_STRIPS][LED_STRIP_MAX_LEDS * 3];
+};
+
+#endif
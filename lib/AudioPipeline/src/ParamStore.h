@@ -0,0 +1,45 @@
+// ParamStore.h — спільний блок LightParams між веб-сервером (пише) і задачами аналізу/світлодіодів (читають).
+// Читачі щокадру порівнюють лише атомарну версію, а коли вона змінилась — знімають копію блоку через
+// seqlock, без м’ютекса і без очікування писача (SeqLock.h). Писачі (обробники HTTP-запитів)
+// домовляються між собою м’ютексом — це не задачі реального часу.
+#ifndef PARAM_STORE_H
+#define PARAM_STORE_H
+
+#include "LightParams.h"
+#include "SeqLock.h"
+
+#include <atomic>
+#include <mutex>
+
+#define PARAM_READ_ATTEMPTS 8 // спроб копії за кадр у задачах реального часу (далі — попередня копія)
+
+class ParamStore {
+public:
+  ParamStore() : block(defaultLightParams()), current(0) {}
+
+  uint32_t version() const { return current.load(std::memory_order_acquire); }
+
+  // Копія блоку для задач реального часу: false — не вдалося за PARAM_READ_ATTEMPTS спроб, out не змінено
+  bool tryRead(LightParams &out) const { return block.tryLoad(out, PARAM_READ_ATTEMPTS); }
+  LightParams read() const { return block.load(); } // для веб-сервера
+
+  // Змінює блок функцією change(LightParams &) -> bool; якщо вона повернула true, блок публікується
+  // з новою версією. Повертає результат change (false — нічого не опубліковано)
+  template <typename F> bool update(F change) {
+    std::lock_guard<std::mutex> lock(writer);
+    LightParams next = block.load(); // інших писачів немає — копія узгоджена з першої спроби
+    uint32_t version = next.version;
+    if (!change(next)) return false;
+    next.version = version + 1;
+    block.store(next);
+    current.store(next.version, std::memory_order_release);
+    return true;
+  }
+
+private:
+  std::mutex writer;
+  SeqLock<LightParams> block;
+  std::atomic<uint32_t> current; // = версія опублікованого блоку (щоб не копіювати блок щокадру)
+};
+
+#endif
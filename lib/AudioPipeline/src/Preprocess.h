@@ -0,0 +1,69 @@
+// Preprocess.h — кроки 1–4 конвеєра (корекція аномалій, видалення DC, IIR-фільтр) одним ядром.
+// Раніше кадр проходився п’ять разів (копія з корекцією, сума, віднімання середнього, IIR, копія назад);
+// тут — два проходи прямо по вхідному буферу FFT:
+//   1) зразки АЦП -> out із заміною аномальних, сума скоригованих (для середнього);
+//   2) віднімання середнього і IIR на місці: out[i - 1] на цей момент уже відфільтроване.
+// Порядок операцій той самий, що й у покрокового варіанта, тож для double результат збігається
+// біт у біт (перевіряє test_preprocess).
+//
+// Тип обчислень T — як у RealFft.h (див. PreprocessMath нижче):
+//   double, float — звичайна арифметика з плаваючою комою;
+//   int32_t       — фіксована кома: зразок АЦП * 2^PREPROCESS_FRACTION_BITS, коефіцієнти IIR у Q30
+//                   (у Q15 похибка коефіцієнта зсуває АЧХ фільтра на ~0.01 одиниці АЦП).
+#ifndef PREPROCESS_H
+#define PREPROCESS_H
+
+#include "AudioConfig.h"
+
+#include <stdint.h>
+
+#define IIR_FEEDBACK 0.7 // IIR-фільтр (крок 4): y[n] = IIR_FEEDBACK * y[n-1] + IIR_INPUT * x[n]
+#define IIR_INPUT 0.3
+
+#define PREPROCESS_FRACTION_BITS 16 // дробових бітів у int32_t: 4095 * 2^16 < 2^31
+
+template <typename T> struct PreprocessMath { // double і float
+  typedef T acc_t;                                      // тип суми зразків кадру
+  static T fromSample(int v) { return (T)v; }          // скоригований зразок АЦП -> T
+  static T mean(acc_t sum, int n) { return sum / n; }
+  static T iir(T previous, T x) { return IIR_FEEDBACK * previous + IIR_INPUT * x; }
+  static double toDouble(T v) { return v; }
+};
+
+template <> struct PreprocessMath<int32_t> { // фіксована кома: сума кадру — у 64 бітах
+  typedef int64_t acc_t;
+  static const int64_t ONE = 1LL << 30;
+  static const int64_t FEEDBACK_Q30 = (int64_t)(IIR_FEEDBACK * ONE + 0.5);
+  static const int64_t INPUT_Q30 = ONE - FEEDBACK_Q30; // сума коефіцієнтів — рівно 1, як IIR_FEEDBACK + IIR_INPUT
+  static int32_t fromSample(int v) { return (int32_t)v << PREPROCESS_FRACTION_BITS; }
+  static int32_t mean(acc_t sum, int n) { return (int32_t)((sum + (sum < 0 ? -n : n) / 2) / n); } // з округленням
+  static int32_t iir(int32_t previous, int32_t x) { return (int32_t)((FEEDBACK_Q30 * previous + INPUT_Q30 * x + ONE / 2) >> 30); }
+  static double toDouble(int32_t v) { return (double)v / (1 << PREPROCESS_FRACTION_BITS); }
+};
+
+// Кроки 1–4 для n зразків АЦП: samples -> out (вхід FFT). onSample(i, сирий, скоригований) викликається
+// в першому проході для кожного зразка — для гілок, яким потрібні дані до видалення DC (проріджування).
+// Аномальний зразок (поза 0..ADC_MAX) замінюється попереднім скоригованим, а перший — на ADC_MID
+template <typename T, typename In, typename Visitor> void preprocessFrame(const In *samples, T *out, int n, Visitor &&onSample) {
+  typedef PreprocessMath<T> M;
+  typename M::acc_t sum = 0;
+  int last = ADC_MID;
+  for (int i = 0; i < n; i++) {
+    In raw = samples[i];
+    if (raw >= 0 && raw <= ADC_MAX) last = (int)raw;
+    out[i] = M::fromSample(last);
+    sum += out[i];
+    onSample(i, raw, last);
+  }
+
+  T mean = M::mean(sum, n);
+  T previous = out[0] - mean;
+  out[0] = previous;
+  for (int i = 1; i < n; i++) out[i] = previous = M::iir(previous, out[i] - mean);
+}
+
+template <typename T, typename In> void preprocessFrame(const In *samples, T *out, int n) {
+  preprocessFrame(samples, out, n, [](int, In, int) {});
+}
+
+#endif
@@ -0,0 +1,87 @@
+#include "Profiler.h"
+
+#if AUDIO_PROFILING
+
+#include <stdio.h>
+#include <string.h>
+
+StageStats Profiler::stats[PROFILE_STAGES];
+std::atomic<bool> Profiler::resetPending[PROFILE_STAGES];
+
+void StageStats::reset() {
+  samples = 0;
+  low = 0xFFFFFFFFu;
+  high = 0;
+  total = 0;
+  memset(buckets, 0, sizeof(buckets));
+}
+
+void StageStats::add(uint32_t ns) {
+  samples++;
+  total += ns;
+  if (ns < low) low = ns;
+  if (ns > high) high = ns;
+  buckets[bucketOf(ns)]++;
+}
+
+int StageStats::bucketOf(uint32_t ns) {
+  if (ns < PROFILE_MIN_NS) return 0;
+  int octave = 31 - __builtin_clz(ns); // найвищий біт: 6 для 64..127 нс
+  int sub = (ns >> (octave - 2)) & (PROFILE_SUBBUCKETS - 1); // наступні два біти — чверть октави
+  int bucket = 1 + (octave - 6) * PROFILE_SUBBUCKETS + sub;
+  return bucket < PROFILE_BUCKETS ? bucket : PROFILE_BUCKETS - 1;
+}
+
+uint32_t StageStats::bucketUpperNs(int bucket) {
+  if (bucket == 0) return PROFILE_MIN_NS;
+  int octave = (bucket - 1) / PROFILE_SUBBUCKETS + 6;
+  int sub = (bucket - 1) % PROFILE_SUBBUCKETS;
+  return (uint32_t)(PROFILE_SUBBUCKETS + sub + 1) << (octave - 2);
+}
+
+uint32_t StageStats::percentileNs(int percent) const {
+  if (samples == 0) return 0;
+  uint64_t target = ((uint64_t)samples * percent + 99) / 100; // скільки вимірів мають бути не більші
+  uint64_t seen = 0;
+  for (int b = 0; b < PROFILE_BUCKETS; b++) {
+    seen += buckets[b];
+    if (seen >= target) {
+      uint32_t upper = bucketUpperNs(b);
+      return upper < high ? upper : high; // межа кошика не більша за справжній максимум
+    }
+  }
+  return high;
+}
+
+const char *Profiler::name(ProfileStage stage) {
+  static const char *const names[PROFILE_STAGES] = {"read",     "prep",  "window", "fft+mag", "lowfft",
+                                                    "goertzel", "bands", "smooth", "render",  "show"};
+  return names[stage];
+}
+
+void Profiler::requestReset() {
+  for (int i = 0; i < PROFILE_STAGES; i++) resetPending[i].store(true, std::memory_order_release);
+}
+
+void Profiler::reset() {
+  for (int i = 0; i < PROFILE_STAGES; i++) {
+    resetPending[i].store(false, std::memory_order_relaxed);
+    stats[i].reset();
+  }
+}
+
+size_t Profiler::report(char *buf, size_t size) {
+  size_t len = 0;
+  int n = snprintf(buf, size, "етап         кадрів       min       avg       p99       max (мкс)\n"); // вирівняно під кирилицю
+  if (n > 0) len += n;
+  for (int i = 0; i < PROFILE_STAGES && len < size; i++) {
+    const StageStats &s = stats[i];
+    if (s.count() == 0 || resetPending[i].load(std::memory_order_acquire)) continue;
+    n = snprintf(buf + len, size - len, "%-9s %9u %9.1f %9.1f %9.1f %9.1f\n", name((ProfileStage)i), (unsigned)s.count(),
+                 s.minNs() / 1000.0, s.avgNs() / 1000.0, s.percentileNs(99) / 1000.0, s.maxNs() / 1000.0);
+    if (n > 0) len += n;
+  }
+  return len < size ? len : size - 1;
+}
+
+#endif
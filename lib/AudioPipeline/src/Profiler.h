@@ -0,0 +1,123 @@
+// Profiler.h — час кожного етапу кадру (читання звуку, DC, IIR, вікно, FFT, діапазони, вивід на LED).
+// PROFILE_SCOPE(етап) на початку блоку заміряє час до кінця блоку: на ESP32 — лічильником тактів
+// процесора (CCOUNT, один такт = 1/240 мкс), на ПК — std::chrono::steady_clock. Для кожного етапу
+// зберігаються min/avg/max і гістограма фіксованого розміру (чверть октави на кошик), з якої береться p99.
+// Вмикається прапорцем збірки -D AUDIO_PROFILING=1; без нього PROFILE_SCOPE — порожній оператор,
+// а класи профілювання не компілюються зовсім.
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#ifndef AUDIO_PROFILING
+#define AUDIO_PROFILING 0
+#endif
+
+enum ProfileStage { // етапи кадру; кожен записує лише одна задача (аналізу або світлодіодів)
+  PROFILE_READ,       // очікування hop нових зразків від джерела
+  PROFILE_PREPROCESS, // 1-4) корекція аномалій, видалення DC, IIR-фільтр і проріджування (одне ядро)
+  PROFILE_WINDOW,     // 5) віконування
+  PROFILE_FFT,        // 5-6) FFT дійсного сигналу разом з амплітудами (вони рахуються в одному проході)
+  PROFILE_LOW_FFT,    // низькочастотне FFT
+  PROFILE_GOERTZEL,   // біни алгоритмом Герцеля
+  PROFILE_BANDS,      // 7-8) діапазони і нормалізація
+  PROFILE_SMOOTH,     // 9) ковзне середнє
+  PROFILE_RENDER,     // малювання режиму в масиви LED
+  PROFILE_SHOW,       // передача на стрічки
+  PROFILE_STAGES,
+};
+
+#if AUDIO_PROFILING
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(ESP_PLATFORM)
+#include <xtensa/hal.h>
+#define PROFILE_TICKS_PER_US (F_CPU / 1000000) // такти процесора (частота не змінюється під час роботи)
+#else
+#include <chrono>
+#define PROFILE_TICKS_PER_US 1000 // наносекунди steady_clock
+#endif
+
+#define PROFILE_MIN_NS 64          // усе коротше — у кошику 0
+#define PROFILE_SUBBUCKETS 4       // кошиків на октаву (похибка p99 — до чверті октави, ~19%)
+#define PROFILE_OCTAVES 20         // від 64 нс до 67 мс
+#define PROFILE_BUCKETS (1 + PROFILE_OCTAVES * PROFILE_SUBBUCKETS)
+
+inline uint32_t profileTicks() {
+#if defined(ESP_PLATFORM)
+  return xthal_get_ccount();
+#else
+  return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+class StageStats { // статистика одного етапу; запис — з однієї задачі, читання для звіту — без блокувань (знімок може бути неузгодженим на один кадр)
+public:
+  StageStats() { reset(); }
+
+  void add(uint32_t ns);
+  void reset();
+
+  uint32_t count() const { return samples; }
+  uint32_t minNs() const { return samples ? low : 0; }
+  uint32_t maxNs() const { return high; }
+  uint32_t avgNs() const { return samples ? (uint32_t)(total / samples) : 0; }
+  uint32_t percentileNs(int percent) const; // верхня межа кошика, в який потрапляє percent% вимірів
+
+  static int bucketOf(uint32_t ns);
+  static uint32_t bucketUpperNs(int bucket);
+
+private:
+  uint32_t samples;
+  uint32_t low, high;
+  uint64_t total;
+  uint32_t buckets[PROFILE_BUCKETS];
+};
+
+// Статистику етапу змінює лише задача, що його записує: звіт читає лічильники без блокувань, а обнулення
+// з іншої задачі (/profile?reset) — лише запит, який задача-власник виконує перед наступним виміром
+class Profiler {
+public:
+  static void record(ProfileStage stage, uint32_t ticks) {
+    if (resetPending[stage].load(std::memory_order_relaxed) && resetPending[stage].exchange(false, std::memory_order_acquire))
+      stats[stage].reset();
+    stats[stage].add((uint64_t)ticks * 1000 / PROFILE_TICKS_PER_US);
+  }
+  static const StageStats &stage(ProfileStage stage) { return stats[stage]; }
+  static const char *name(ProfileStage stage);
+  static void requestReset(); // з будь-якої задачі: кожен етап почнеться заново з наступного виміру
+  static void reset();        // одразу — лише коли етапи ніхто не записує (бенчмарк, тести)
+
+  // Текстова таблиця етапів (кількість, min/avg/p99/max у мкс) у buf; повертає довжину рядка.
+  // Етапи із запитом на обнулення, який власник ще не виконав, не показуються
+  static size_t report(char *buf, size_t size);
+
+private:
+  static StageStats stats[PROFILE_STAGES];
+  static std::atomic<bool> resetPending[PROFILE_STAGES];
+};
+
+class ScopedTimer {
+public:
+  explicit ScopedTimer(ProfileStage stage) : stage(stage), start(profileTicks()) {}
+  ~ScopedTimer() { Profiler::record(stage, profileTicks() - start); }
+
+private:
+  ProfileStage stage;
+  uint32_t start;
+};
+
+#define PROFILE_JOIN2(a, b) a##b
+#define PROFILE_JOIN(a, b) PROFILE_JOIN2(a, b)
+#define PROFILE_SCOPE(stage) ScopedTimer PROFILE_JOIN(profileTimer, __LINE__)(stage)
+
+#else
+
+#define PROFILE_SCOPE(stage) \
+  do {                       \
+  } while (0)
+
+#endif
+
+#endif
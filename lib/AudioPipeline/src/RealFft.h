@@ -0,0 +1,130 @@
+// RealFft.h — FFT для дійсного сигналу (уявна частина якого завжди 0).
+// N дійсних зразків пакуються у N/2 комплексних (парні -> Re, непарні -> Im), рахується комплексне
+// FFT розміром N/2, а потім окремий прохід "розділяє" результат у N/2+1 неповторних бінів.
+// Біни N/2+1..N-1 — дзеркальні (комплексно спряжені) і не обчислюються зовсім.
+//
+// Тип обчислень T задається шаблоном (див. SPECTRUM_TYPE в AudioConfig.h):
+//   double  — еталон, але на ESP32 рахується програмно (FPU апаратно підтримує лише float);
+//   float   — апаратний FPU ESP32;
+//   int16_t — Q15 з фіксованою комою, int32_t — Q31: без FPU, з масштабуванням 1/2 на кожному етапі,
+//             щоб не було переповнення (точність трохи нижча, межі перевіряє test_spectrum).
+#ifndef REAL_FFT_H
+#define REAL_FFT_H
+
+#include "SpectrumTables.h"
+
+#include <math.h>
+#include <stdint.h>
+
+template <typename T> struct FftMath { // double і float: звичайна арифметика з плаваючою комою
+  typedef T acc_t;                                        // тип проміжних сум
+  static constexpr T twiddle(double v) { return (T)v; }   // поворотний множник у форматі T
+  static T fromInput(double v) { return (T)v; }           // зразок -> T
+  static acc_t mul(T a, T b) { return a * b; }            // добуток у форматі T
+  static T stage(acc_t v) { return v; }                   // результат етапу FFT (без масштабування)
+  static T half(acc_t v) { return v * (T)0.5; }           // (a + b) / 2
+  static double magnitude(acc_t re, acc_t im) { return sqrt(re * re + im * im); }
+  static double outputScale(int) { return 1; }           // множник, що повертає амплітуди в одиниці входу
+};
+
+template <> inline double FftMath<float>::magnitude(float re, float im) { return sqrtf(re * re + im * im); }
+
+template <> struct FftMath<int16_t> { // Q15: значення в [-1, 1) зберігаються як int16 * 2^-15
+  typedef int32_t acc_t;
+  static const int INPUT_SHIFT = 3; // зразки АЦП (до ±4096) множимо на 8, щоб зайняти весь діапазон Q15
+  static constexpr int16_t twiddle(double v) { return (int16_t)(v * 32767 + (v < 0 ? -0.5 : 0.5)); }
+  static int16_t fromInput(double v) {
+    long q = lround(v * (1 << INPUT_SHIFT));
+    return (int16_t)(q > 32767 ? 32767 : (q < -32768 ? -32768 : q));
+  }
+  static acc_t mul(int16_t a, int16_t b) { return ((int32_t)a * b) >> 15; }
+  static int16_t stage(acc_t v) { return (int16_t)(v >> 1); } // кожен етап ділимо на 2 — без переповнення
+  static int16_t half(acc_t v) { return (int16_t)(v >> 1); }
+  static double magnitude(acc_t re, acc_t im) { return sqrtf((float)re * re + (float)im * im); }
+  static double outputScale(int complexSize) { return (double)complexSize / (1 << INPUT_SHIFT); }
+};
+
+template <> struct FftMath<int32_t> { // Q31: як Q15, але з 64-бітними добутками і меншим шумом округлення
+  typedef int64_t acc_t;
+  static const int INPUT_SHIFT = 19; // ±4096 * 2^19 = ±2^31
+  static constexpr int32_t twiddle(double v) { return (int32_t)(v * 2147483647.0 + (v < 0 ? -0.5 : 0.5)); }
+  static int32_t fromInput(double v) {
+    long long q = llround(v * (1 << INPUT_SHIFT));
+    return (int32_t)(q > 2147483647LL ? 2147483647LL : (q < -2147483648LL ? -2147483648LL : q));
+  }
+  static acc_t mul(int32_t a, int32_t b) { return ((int64_t)a * b) >> 31; }
+  static int32_t stage(acc_t v) { return (int32_t)(v >> 1); }
+  static int32_t half(acc_t v) { return (int32_t)(v >> 1); }
+  static double magnitude(acc_t re, acc_t im) { return sqrtf((float)re * re + (float)im * im); }
+  static double outputScale(int complexSize) { return (double)complexSize / (1 << INPUT_SHIFT); }
+};
+
+template <int N, typename T = double> class RealFft {
+public:
+  static const int BINS = N / 2 + 1; // кількість неповторних бінів (0..N/2)
+  typedef FftMath<T> Math;
+  typedef typename Math::acc_t acc_t;
+
+  // in — N дійсних зразків (уже після віконування), mag — BINS амплітуд
+  void magnitudes(const double *in, double *mag) {
+    const int M = N / 2;
+    for (int n = 0; n < M; n++) { // пакуємо: z[n] = x[2n] + j*x[2n+1]
+      re[n] = Math::fromInput(in[2 * n]);
+      im[n] = Math::fromInput(in[2 * n + 1]);
+    }
+    complexFft();
+
+    // Розділення: X[k] = E[k] + W_N^k * O[k], де E і O — спектри парних і непарних зразків:
+    // E[k] = (Z[k] + conj(Z[M-k])) / 2, O[k] = (Z[k] - conj(Z[M-k])) / 2j
+    const auto &wr = TwiddleTable<Math, N>::re, &wi = TwiddleTable<Math, N>::im;
+    const double scale = Math::outputScale(M);
+    mag[0] = fabs(((double)re[0] + im[0]) * scale);
+    mag[M] = fabs(((double)re[0] - im[0]) * scale);
+    for (int k = 1; k < M; k++) {
+      acc_t a = re[k], b = im[k], c = re[M - k], d = im[M - k];
+      T er = Math::half(a + c), ei = Math::half(b - d);
+      T orr = Math::half(b + d), oi = Math::half(c - a);
+      acc_t xr = er + Math::mul(wr[k], orr) - Math::mul(wi[k], oi);
+      acc_t xi = ei + Math::mul(wr[k], oi) + Math::mul(wi[k], orr);
+      mag[k] = Math::magnitude(xr, xi) * scale;
+    }
+  }
+
+private:
+  void complexFft() { // класичне FFT radix-2 розміром N/2 "на місці"
+    const int M = N / 2;
+    for (int i = 1, j = 0; i < M; i++) { // перестановка з бітовою інверсією індексів
+      int bit = M >> 1;
+      for (; j & bit; bit >>= 1) j ^= bit;
+      j ^= bit;
+      if (i < j) {
+        T t = re[i];
+        re[i] = re[j];
+        re[j] = t;
+        t = im[i];
+        im[i] = im[j];
+        im[j] = t;
+      }
+    }
+    const auto &wr = TwiddleTable<Math, N>::re, &wi = TwiddleTable<Math, N>::im; // W_N^k (флеш, обчислено компілятором)
+    for (int len = 2; len <= M; len <<= 1) {
+      int step = N / len; // W_len^k = W_N^(k * N/len)
+      for (int i = 0; i < M; i += len) {
+        for (int k = 0; k < len / 2; k++) {
+          int p = i + k, q = p + len / 2;
+          acc_t tr = Math::mul(re[q], wr[k * step]) - Math::mul(im[q], wi[k * step]);
+          acc_t ti = Math::mul(re[q], wi[k * step]) + Math::mul(im[q], wr[k * step]);
+          acc_t pr = re[p], pi = im[p];
+          re[q] = Math::stage(pr - tr);
+          im[q] = Math::stage(pi - ti);
+          re[p] = Math::stage(pr + tr);
+          im[p] = Math::stage(pi + ti);
+        }
+      }
+    }
+  }
+
+  T re[N / 2], im[N / 2]; // робочі масиви комплексного FFT
+};
+
+#endif
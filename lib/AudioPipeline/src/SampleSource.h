@@ -0,0 +1,25 @@
+// SampleSource.h — абстрактне джерело зразків звуку.
+// Реалізації захоплюють звук безперервно (DMA-кільце блоків на ESP32, WAV-файл на ПК),
+// а конвеєр лише забирає готові блоки — без analogRead і delayMicroseconds між зразками.
+#ifndef SAMPLE_SOURCE_H
+#define SAMPLE_SOURCE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+class SampleSource {
+public:
+  virtual ~SampleSource() {}
+
+  virtual bool begin() = 0; // запуск захоплення; false — якщо джерело недоступне
+
+  // Копіює count зразків (значення АЦП 0–4095) у dst. Чекає не довше timeoutMs,
+  // якщо стільки зразків ще не захоплено. Повертає кількість реально зчитаних зразків.
+  virtual size_t read(int *dst, size_t count, uint32_t timeoutMs) = 0;
+
+  virtual size_t available() = 0; // скільки зразків уже захоплено і можна прочитати без очікування
+
+  virtual uint32_t overruns() const { return 0; } // скільки разів кільце переповнилось і звук втрачено
+};
+
+#endif
@@ -0,0 +1,63 @@
+// SeqLock.h — послідовний замок (seqlock) для невеликої структури з одним писачем і читачами, які не можуть чекати.
+// Писач робить лічильник непарним, записує дані і робить його парним; читач копіює дані без жодних
+// блокувань і повторює копію, якщо лічильник був непарним або змінився за час копіювання — тож ніколи
+// не отримує суміш старих і нових полів. Дані зберігаються як атомарні 32-бітні слова (relaxed), щоб
+// одночасне читання і запис не були гонкою даних для компілятора.
+// Писач — один одночасно (кілька писачів мають домовитись між собою, наприклад м’ютексом).
+#ifndef SEQ_LOCK_H
+#define SEQ_LOCK_H
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+
+template <typename T> class SeqLock {
+  static_assert(std::is_trivially_copyable<T>::value, "дані копіюються побайтово");
+  static const size_t WORDS = (sizeof(T) + 3) / 4;
+
+public:
+  explicit SeqLock(const T &value) : sequence(0) { store(value); }
+
+  void store(const T &value) { // лише один писач одночасно
+    uint32_t w[WORDS] = {};
+    memcpy(w, &value, sizeof(T));
+    uint32_t s = sequence.load(std::memory_order_relaxed);
+    sequence.store(s + 1, std::memory_order_relaxed); // непарний — запис триває
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < WORDS; i++) words[i].store(w[i], std::memory_order_relaxed);
+    sequence.store(s + 2, std::memory_order_release);
+  }
+
+  // Узгоджена копія за щонайбільше attempts спроб; false — писач весь час заважав (out не змінено).
+  // Задачі реального часу не крутяться в циклі без кінця: якщо писача на іншому ядрі витіснили
+  // посеред запису, вони лишаються з попередньою копією до наступного кадру
+  bool tryLoad(T &out, int attempts) const {
+    uint32_t w[WORDS];
+    while (attempts-- > 0) {
+      uint32_t before = sequence.load(std::memory_order_acquire);
+      if (before & 1) continue;
+      for (size_t i = 0; i < WORDS; i++) w[i] = words[i].load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (sequence.load(std::memory_order_relaxed) != before) continue;
+      memcpy(&out, w, sizeof(T));
+      return true;
+    }
+    return false;
+  }
+
+  T load() const { // чекає, скільки треба (для задач, яким не критичний час)
+    T value;
+    while (!tryLoad(value, 1000)) {}
+    return value;
+  }
+
+  uint32_t writes() const { return sequence.load(std::memory_order_acquire) / 2; }
+
+private:
+  std::atomic<uint32_t> sequence; // парний — дані узгоджені; кожен запис додає 2
+  std::atomic<uint32_t> words[WORDS];
+};
+
+#endif
@@ -0,0 +1,52 @@
+// SlidingWindow.h — ковзне вікно аналізу з кроком (hop) менше за SAMPLES.
+// Кільце зберігає останні SAMPLES зразків; новий кадр для FFT готовий після кожних hop нових
+// зразків і на (SAMPLES - hop) зразків перекривається з попереднім. Так кожен зразок звуку
+// потрапляє в аналіз, а спектр оновлюється частіше без додаткового збору даних.
+#ifndef SLIDING_WINDOW_H
+#define SLIDING_WINDOW_H
+
+#include "AudioConfig.h"
+
+#include <string.h>
+
+#define HOP_MIN 32 // менший крок — забагато FFT на секунду для ядра ESP32
+
+class SlidingWindow {
+public:
+  explicit SlidingWindow(int hop = SAMPLES) : head(0), filled(0), pending(0) { setHop(hop); }
+
+  static int clampHop(int value) { return value < HOP_MIN ? HOP_MIN : (value > SAMPLES ? SAMPLES : value); }
+  static int overlapPercent(int hop) { return 100 * (SAMPLES - hop) / SAMPLES; } // перекриття сусідніх кадрів
+
+  void setHop(int value) { hopSize = clampHop(value); }
+  int hop() const { return hopSize; }
+
+  void push(const int *samples, int count) { // додаємо нові зразки в кільце
+    for (int i = 0; i < count; i++) {
+      ring[head] = samples[i];
+      head = (head + 1) % SAMPLES;
+    }
+    filled = (filled + count > SAMPLES) ? SAMPLES : filled + count;
+    pending += count;
+  }
+
+  bool ready() const { return filled == SAMPLES && pending >= hopSize; } // назбирався новий крок
+
+  // Останні SAMPLES зразків від найстарішого до найновішого. Кадр містить усі нові зразки, тож
+  // лічильник нових обнуляється: наступний кадр — після наступних hop зразків, а не одразу ж із тим
+  // самим вмістом (зразки, назбирані до першого повного вікна, теж не "борг" на кілька кадрів)
+  void frame(int *out) {
+    memcpy(out, ring + head, (SAMPLES - head) * sizeof(int));
+    memcpy(out + SAMPLES - head, ring, head * sizeof(int));
+    pending = 0;
+  }
+
+private:
+  int ring[SAMPLES];
+  int head;    // куди буде записано наступний зразок (він же — найстаріший зразок вікна)
+  int filled;  // скільки зразків у кільці (до першого повного вікна)
+  int pending; // нових зразків після останнього кадру
+  int hopSize;
+};
+
+#endif
@@ -0,0 +1,79 @@
+// SpectrumTables.h — таблиці вікон і поворотних множників FFT, обчислені під час компіляції.
+// Таблиці — constexpr-дані, тому на ESP32 лежать у флеш-пам’яті (.rodata) і не займають RAM,
+// а під час роботи не викликається жоден cos()/sin(): віконування — лише множення.
+#ifndef SPECTRUM_TABLES_H
+#define SPECTRUM_TABLES_H
+
+#include <array>
+
+enum WindowType { // ті самі вікна і формули, що й у бібліотеці arduinoFFT
+  WINDOW_RECTANGLE,
+  WINDOW_HAMMING,
+  WINDOW_HANN,
+  WINDOW_BLACKMAN,
+};
+
+namespace tables {
+
+constexpr double kPi = 3.14159265358979323846; // не PI: Arduino.h визначає PI макросом
+
+constexpr double cosine(double x) { // cos(x) для обчислення під час компіляції (ряд Тейлора)
+  while (x > kPi) x -= 2 * kPi;     // зводимо до [-π, π], де ряд швидко збігається
+  while (x < -kPi) x += 2 * kPi;
+  double term = 1, sum = 1;
+  for (int n = 1; n < 24; n++) {
+    term *= -x * x / ((2 * n - 1) * (2 * n));
+    sum += term;
+  }
+  return sum;
+}
+
+constexpr double sine(double x) { return cosine(x - kPi / 2); }
+
+constexpr double squareRoot(double x) { // sqrt(x) під час компіляції (метод Ньютона), x >= 0
+  double r = x > 1 ? x : 1;
+  for (int n = 0; n < 64; n++) r = (r + x / r) / 2;
+  return r;
+}
+
+constexpr double windowWeight(WindowType type, int i, int n) { // вага i-го зразка з n
+  double ratio = (double)i / (n - 1);
+  switch (type) {
+  case WINDOW_HAMMING: return 0.54 - 0.46 * cosine(2 * kPi * ratio);
+  case WINDOW_HANN: return 0.54 - 0.54 * cosine(2 * kPi * ratio); // як у arduinoFFT
+  case WINDOW_BLACKMAN: return 0.42323 - 0.49755 * cosine(2 * kPi * ratio) + 0.07922 * cosine(4 * kPi * ratio);
+  default: return 1.0;
+  }
+}
+
+template <typename T, int N, WindowType W> constexpr std::array<T, N> makeWindow() {
+  std::array<T, N> table{};
+  for (int i = 0; i < N; i++) table[i] = (T)windowWeight(W, i, N);
+  return table;
+}
+
+template <typename Math, int N, bool Sine> constexpr auto makeTwiddles() { // W_N^k = cos(2πk/N) - j*sin(2πk/N), k < N/2
+  std::array<decltype(Math::twiddle(0.0)), N / 2> table{};
+  for (int k = 0; k < N / 2; k++) table[k] = Math::twiddle(Sine ? -sine(2 * kPi * k / N) : cosine(2 * kPi * k / N));
+  return table;
+}
+
+} // namespace tables
+
+// Коефіцієнти вікна для N зразків; віконування — просто x[i] *= WindowTable<...>::weights[i]
+template <int N, WindowType W, typename T = double> struct WindowTable {
+  static constexpr std::array<T, N> weights = tables::makeWindow<T, N, W>();
+};
+
+// Поворотні множники FFT розміру N у форматі обчислень Math (див. FftMath у RealFft.h)
+template <typename Math, int N> struct TwiddleTable {
+  static constexpr auto re = tables::makeTwiddles<Math, N, false>();
+  static constexpr auto im = tables::makeTwiddles<Math, N, true>();
+};
+
+template <int N, WindowType W, typename T> inline void applyWindow(T *data) { // віконування без тригонометрії
+  const std::array<T, N> &weights = WindowTable<N, W, T>::weights;
+  for (int i = 0; i < N; i++) data[i] *= weights[i];
+}
+
+#endif
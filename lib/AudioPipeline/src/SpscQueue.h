@@ -0,0 +1,42 @@
+// SpscQueue.h — черга без блокувань для одного виробника і одного споживача (SPSC).
+// Виробник (задача аналізу звуку) змінює лише head, споживач (задача світлодіодів) — лише tail,
+// тому м’ютекси не потрібні: досить атомарних індексів із порядком пам’яті acquire/release.
+// Елементи копіюються цілком — черга фіксованого розміру, без динамічної пам’яті.
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+template <typename T, uint32_t CAPACITY> class SpscQueue {
+  static_assert(CAPACITY > 0 && (CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY має бути степенем двійки");
+
+public:
+  SpscQueue() : head(0), tail(0) {}
+
+  bool push(const T &item) { // лише виробник; false — черга повна (елемент не додано)
+    uint32_t h = head.load(std::memory_order_relaxed);
+    if (h - tail.load(std::memory_order_acquire) == CAPACITY) return false;
+    slots[h & (CAPACITY - 1)] = item;
+    head.store(h + 1, std::memory_order_release); // елемент записано повністю — тепер його видно споживачу
+    return true;
+  }
+
+  bool pop(T &item) { // лише споживач; false — черга порожня
+    uint32_t t = tail.load(std::memory_order_relaxed);
+    if (head.load(std::memory_order_acquire) == t) return false;
+    item = slots[t & (CAPACITY - 1)];
+    tail.store(t + 1, std::memory_order_release); // комірка вільна — виробник може її перезаписати
+    return true;
+  }
+
+  size_t size() const { return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire); }
+
+private:
+  T slots[CAPACITY];
+  std::atomic<uint32_t> head; // скільки елементів додано (переповнення uint32 не заважає: рахуємо різницю)
+  std::atomic<uint32_t> tail; // скільки елементів забрано
+};
+
+#endif
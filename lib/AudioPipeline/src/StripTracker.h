@@ -0,0 +1,63 @@
+// StripTracker.h — відстеження змін у стрічках світлодіодів між кадрами.
+// Для кожної стрічки зберігається лише хеш (FNV-1a) її пікселів у момент останнього виводу — 4 байти
+// замість копії кадру. Якщо після малювання хеш не змінився, стрічку не треба знову передавати по дроту.
+#ifndef STRIP_TRACKER_H
+#define STRIP_TRACKER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+template <int STRIPS> class StripTracker {
+  static_assert(STRIPS <= 32, "маска змінених стрічок — 32 біти");
+
+public:
+  StripTracker() : shownFrames(0), skippedFrames(0) {
+    for (int i = 0; i < STRIPS; i++) {
+      pixels[i] = nullptr;
+      bytes[i] = 0;
+      hashes[i] = 0;
+    }
+    valid = 0;
+  }
+
+  void attach(int strip, const void *data, size_t size) { // масив пікселів стрічки і його розмір у байтах
+    pixels[strip] = (const uint8_t *)data;
+    bytes[strip] = size;
+    valid &= ~(1u << strip); // ще не виводилась — вважаємо зміненою
+  }
+
+  // Маска стрічок, чий вміст змінився з попереднього виклику (біт i — стрічка i); новий вміст
+  // запам’ятовується, тож виклик — один раз на кадр, перед виводом. 0 — кадр можна не показувати
+  uint32_t changed() {
+    uint32_t mask = 0;
+    for (int i = 0; i < STRIPS; i++) {
+      uint32_t h = hash(pixels[i], bytes[i]);
+      if (!(valid & (1u << i)) || h != hashes[i]) mask |= 1u << i;
+      hashes[i] = h;
+      valid |= 1u << i;
+    }
+    if (mask) shownFrames++;
+    else skippedFrames++;
+    return mask;
+  }
+
+  void invalidate() { valid = 0; } // наступний changed() позначить усі стрічки (наприклад, після зміни яскравості)
+
+  uint32_t shown() const { return shownFrames; }     // кадрів, які довелося передати
+  uint32_t skipped() const { return skippedFrames; } // кадрів без змін (вивід пропущено)
+
+  static uint32_t hash(const uint8_t *data, size_t size) { // FNV-1a, 32 біти
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < size; i++) h = (h ^ data[i]) * 16777619u;
+    return h;
+  }
+
+private:
+  const uint8_t *pixels[STRIPS];
+  size_t bytes[STRIPS];
+  uint32_t hashes[STRIPS]; // хеш пікселів під час останнього виводу
+  uint32_t valid;          // біт i — hashes[i] відповідає тому, що зараз світиться
+  uint32_t shownFrames, skippedFrames;
+};
+
+#endif
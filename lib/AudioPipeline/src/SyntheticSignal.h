@@ -0,0 +1,33 @@
+// SyntheticSignal.h — згенеровані "записи" у шкалі АЦП для бенчмарку (src/bench) і тестів (test/),
+// щоб без плати і без файлів запису мати однаковий відтворюваний сигнал. Прошивка цей файл не використовує.
+#ifndef SYNTHETIC_SIGNAL_H
+#define SYNTHETIC_SIGNAL_H
+
+#include "AudioConfig.h"
+
+#include <math.h>
+#include <vector>
+
+// Баси + середні + високі + шум навколо ADC_MID, гучність повільно змінюється; frames кадрів по SAMPLES
+inline std::vector<int> synthSamples(int frames) {
+  std::vector<int> samples;
+  unsigned int seed = 12345;
+  for (int n = 0; n < frames * SAMPLES; n++) {
+    double t = (double)n / SAMPLING_FREQ;
+    double level = 0.5 + 0.5 * sin(2 * M_PI * 0.5 * t); // повільна зміна гучності
+    double s = 600 * sin(2 * M_PI * 120 * t) + 300 * sin(2 * M_PI * 1000 * t) + 150 * sin(2 * M_PI * 3500 * t);
+    seed = seed * 1103515245 + 12345;
+    double noise = ((seed >> 16) % 200) - 100.0;
+    samples.push_back(ADC_MID + (int)(level * s + noise));
+  }
+  return samples;
+}
+
+// Чистий тон hz з амплітудою amplitude одиниць АЦП: count зразків, починаючи із зразка first потоку
+inline std::vector<int> toneSamples(double hz, int count, double amplitude = 800, long first = 0) {
+  std::vector<int> samples(count);
+  for (int i = 0; i < count; i++) samples[i] = ADC_MID + (int)lround(amplitude * sin(2 * M_PI * hz * (first + i) / SAMPLING_FREQ));
+  return samples;
+}
+
+#endif
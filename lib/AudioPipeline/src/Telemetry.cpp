@@ -0,0 +1,27 @@
+#include "Telemetry.h"
+
+TelemetryChannel::TelemetryChannel() : droppedCount(0) {
+  for (int c = 0; c < TELEMETRY_CATEGORIES; c++) {
+    interval[c] = defaultIntervalMs((TelemetryCategory)c);
+    last[c] = 0;
+    logged[c] = false;
+  }
+}
+
+uint32_t TelemetryChannel::defaultIntervalMs(TelemetryCategory category) {
+  switch (category) {
+  case TELEMETRY_SIGNAL: return 5000; // 128 зразків — найдовше повідомлення
+  case TELEMETRY_BANDS: return 5000;
+  case TELEMETRY_STATS: return 5000;
+  case TELEMETRY_SPINNER: return 1000; // крок кола буває кожні кілька мс — друкуємо не частіше разу на секунду
+  case TELEMETRY_BOOT: return 0; // один раз за старт
+  default: return 1000;
+  }
+}
+
+bool TelemetryChannel::due(TelemetryCategory category, uint32_t nowMs) {
+  if (logged[category] && nowMs - last[category] < interval[category]) return false;
+  logged[category] = true;
+  last[category] = nowMs;
+  return true;
+}
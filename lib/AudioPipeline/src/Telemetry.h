@@ -0,0 +1,76 @@
+// Telemetry.h — налагоджувальні дані без блокування задач реального часу.
+// Задача, що логує, лише кладе двійкові записи (масив float) у свою SPSC-чергу — без форматування
+// і без Serial; окрема задача з низьким пріоритетом забирає записи й друкує їх. Якщо черга повна,
+// повідомлення відкидається цілим (рахується в dropped), а задача не чекає. Кожна категорія має
+// власний ліміт частоти: due() перевіряється до підготовки даних, тож зайві повідомлення нічого не коштують.
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include "SpscQueue.h"
+
+#include <stdint.h>
+
+#define TELEMETRY_VALUES 8 // значень в одному записі (довші повідомлення діляться на частини)
+#define TELEMETRY_DEPTH 64 // записів у черзі однієї задачі (~2.5 КБ)
+
+enum TelemetryCategory {
+  TELEMETRY_SIGNAL,  // "сирі" зразки АЦП кадру (до корекції аномалій і видалення DC)
+  TELEMETRY_BANDS,   // діапазони, ampR/ampG/ampB і середня енергія
+  TELEMETRY_STATS,   // лічильники: пропущені кадри аналізу, виведені/незмінні кадри LED, перевищення, деградація
+  TELEMETRY_SPINNER, // крок кола в mode 2: час від попереднього кроку і поріг
+  TELEMETRY_BOOT,    // старт: мс від увімкнення до першого кадру світлодіодів
+  TELEMETRY_CATEGORIES,
+};
+
+struct TelemetryRecord {
+  uint32_t timeMs;
+  uint8_t category;
+  uint8_t part;  // номер частини повідомлення (0..parts-1)
+  uint8_t parts;
+  uint8_t count; // значень у цьому записі
+  float values[TELEMETRY_VALUES];
+};
+
+class TelemetryChannel { // один виробник (задача, що логує) і один споживач (задача виводу)
+public:
+  TelemetryChannel();
+
+  void setInterval(TelemetryCategory category, uint32_t ms) { interval[category] = ms; } // 0 — без обмеження
+  static uint32_t defaultIntervalMs(TelemetryCategory category);
+
+  // Чи можна вже логувати категорію (минув її інтервал); true — час запам’ятовується як останній запис
+  bool due(TelemetryCategory category, uint32_t nowMs);
+
+  // Кладе повідомлення з count значень; false — у черзі немає місця для всіх частин (повідомлення відкинуто)
+  template <typename T> bool log(TelemetryCategory category, uint32_t nowMs, const T *values, int count) {
+    int parts = (count + TELEMETRY_VALUES - 1) / TELEMETRY_VALUES;
+    if (parts == 0) parts = 1;
+    if (TELEMETRY_DEPTH - queue.size() < (size_t)parts) {
+      droppedCount++;
+      return false;
+    }
+    for (int p = 0; p < parts; p++) {
+      TelemetryRecord r;
+      r.timeMs = nowMs;
+      r.category = category;
+      r.part = p;
+      r.parts = parts;
+      r.count = 0;
+      for (int i = p * TELEMETRY_VALUES; i < count && r.count < TELEMETRY_VALUES; i++) r.values[r.count++] = (float)values[i];
+      queue.push(r);
+    }
+    return true;
+  }
+
+  bool pop(TelemetryRecord &record) { return queue.pop(record); } // лише задача виводу
+  uint32_t dropped() const { return droppedCount; }
+
+private:
+  SpscQueue<TelemetryRecord, TELEMETRY_DEPTH> queue;
+  uint32_t interval[TELEMETRY_CATEGORIES];
+  uint32_t last[TELEMETRY_CATEGORIES];
+  bool logged[TELEMETRY_CATEGORIES]; // категорію вже логували (перший запис — без очікування інтервалу)
+  uint32_t droppedCount;
+};
+
+#endif
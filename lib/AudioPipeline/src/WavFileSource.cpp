@@ -0,0 +1,82 @@
+#include "WavFileSource.h"
+
+#include "AudioConfig.h"
+
+#include <string.h>
+
+static uint32_t readLe(FILE *file, int bytes) { // WAV зберігає числа у little-endian
+  uint32_t value = 0;
+  for (int i = 0; i < bytes; i++) {
+    int c = fgetc(file);
+    if (c == EOF) return 0;
+    value |= (uint32_t)c << (8 * i);
+  }
+  return value;
+}
+
+WavFileSource::WavFileSource(const char *path, bool loop)
+    : path(path), loop(loop), file(NULL), dataStart(0), rate(0), channels(0), bits(0), total(0), pos(0) {}
+
+WavFileSource::~WavFileSource() {
+  if (file) fclose(file);
+}
+
+bool WavFileSource::begin() {
+  file = fopen(path, "rb");
+  if (!file) return false;
+
+  char id[4];
+  if (fread(id, 1, 4, file) != 4 || memcmp(id, "RIFF", 4) != 0) return false;
+  readLe(file, 4);
+  if (fread(id, 1, 4, file) != 4 || memcmp(id, "WAVE", 4) != 0) return false;
+
+  // Перебираємо блоки (chunks): потрібні "fmt " (формат) і "data" (зразки)
+  while (fread(id, 1, 4, file) == 4) {
+    uint32_t size = readLe(file, 4);
+    if (memcmp(id, "fmt ", 4) == 0) {
+      if (size < 16) return false; // коротший блок не містить розрядності (а пропуск решти блоку став би від’ємним)
+      uint16_t format = readLe(file, 2);
+      channels = readLe(file, 2);
+      rate = readLe(file, 4);
+      readLe(file, 4); // byte rate
+      readLe(file, 2); // block align
+      bits = readLe(file, 2);
+      if (format != 1 || (bits != 8 && bits != 16) || channels == 0) return false; // лише PCM 8/16 біт
+      fseek(file, size - 16 + (size & 1), SEEK_CUR);
+    } else if (memcmp(id, "data", 4) == 0) {
+      if (bits == 0) return false; // "data" раніше за "fmt "
+      dataStart = ftell(file);
+      total = size / (channels * (bits / 8));
+      return total > 0;
+    } else {
+      fseek(file, size + (size & 1), SEEK_CUR);
+    }
+  }
+  return false;
+}
+
+int WavFileSource::readSample() {
+  int sample;
+  if (bits == 16) sample = ((int16_t)readLe(file, 2)) >> 4; // 16 біт -> 12 біт
+  else sample = ((int)readLe(file, 1) - 128) << 4;           // 8 біт (беззнакові) -> 12 біт
+  if (channels > 1) fseek(file, (channels - 1) * (bits / 8), SEEK_CUR); // решту каналів пропускаємо
+  return ADC_MID + sample;
+}
+
+size_t WavFileSource::read(int *dst, size_t count, uint32_t) {
+  if (!file || total == 0) return 0;
+  size_t done = 0;
+  while (done < count) {
+    if (!loop && pos >= total) break;
+    if (pos % total == 0) fseek(file, dataStart, SEEK_SET); // початок файлу (або нове коло у режимі loop)
+    dst[done++] = readSample();
+    pos++;
+  }
+  return done;
+}
+
+size_t WavFileSource::available() {
+  if (!file || total == 0) return 0;
+  if (loop) return total - pos % total; // до кінця поточного кола
+  return total - pos;
+}
@@ -0,0 +1,37 @@
+// WavFileSource.h — джерело зразків із WAV-файлу (PCM 8/16 біт) для native-збірки: бенчмарку і тестів.
+// Зразки перераховуються у шкалу 12-бітного АЦП ESP32 (0–4095, тиша = 2048).
+#ifndef WAV_FILE_SOURCE_H
+#define WAV_FILE_SOURCE_H
+
+#include "SampleSource.h"
+
+#include <stdio.h>
+
+class WavFileSource : public SampleSource {
+public:
+  explicit WavFileSource(const char *path, bool loop = false);
+  ~WavFileSource();
+
+  bool begin() override;
+  size_t read(int *dst, size_t count, uint32_t timeoutMs) override;
+  size_t available() override;
+
+  uint32_t sampleRate() const { return rate; }
+  size_t position() const { return pos; }   // скільки зразків уже віддано
+  size_t totalSamples() const { return total; }
+
+private:
+  int readSample(); // наступний зразок першого каналу у шкалі АЦП
+
+  const char *path;
+  bool loop;
+  FILE *file;
+  long dataStart;     // зміщення блоку "data" у файлі
+  uint32_t rate;
+  uint16_t channels;
+  uint16_t bits;
+  size_t total; // кількість зразків (кадрів) у файлі
+  size_t pos;
+};
+
+#endif
@@ -0,0 +1,27 @@
+#include "FastLedOutput.h"
+
+#include "Leds.h"
+
+template <uint8_t PIN> static void addController(const LedStrip &s) {
+  FastLED.addLeds<WS2812B, PIN, GRB>((CRGB *)s.pixels, s.count);
+}
+
+bool FastLedOutput::begin() {
+  // Пін у FastLED — параметр шаблону, тому для кожного піна стрічки потрібен свій case
+  for (int i = 0; i < stripTotal; i++) {
+    switch (strips[i].pin) {
+    case LED_PIN_16_CIRCLE: addController<LED_PIN_16_CIRCLE>(strips[i]); break;
+    case LED_PIN_12_CIRCLE: addController<LED_PIN_12_CIRCLE>(strips[i]); break;
+    case LED_PIN_L_SQUARE: addController<LED_PIN_L_SQUARE>(strips[i]); break;
+    case LED_PIN_R_SQUARE: addController<LED_PIN_R_SQUARE>(strips[i]); break;
+    default: return false; // пін не описаний у Leds.h
+    }
+  }
+  return true;
+}
+
+void FastLedOutput::show(uint32_t mask) {
+  if (!(mask & allStrips())) return;
+  FastLED.setBrightness(level);
+  FastLED.show();
+}
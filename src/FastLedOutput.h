@@ -0,0 +1,15 @@
+// FastLedOutput.h — вивід на стрічки через бібліотеку FastLED (колишній спосіб, LED_OUTPUT_FASTLED).
+// FastLED не вміє передавати окремі стрічки: її RMT-драйвер на ESP32 чекає show() усіх контролерів,
+// тож будь-яка ненульова маска передає всі стрічки.
+#ifndef FAST_LED_OUTPUT_H
+#define FAST_LED_OUTPUT_H
+
+#include "LedOutput.h"
+
+class FastLedOutput : public LedOutput {
+public:
+  bool begin() override; // додає контролер FastLED для кожної стрічки (піни — з Leds.h)
+  void show(uint32_t mask) override;
+};
+
+#endif
@@ -0,0 +1,63 @@
+#include "I2sAdcSource.h"
+
+#include "AudioConfig.h"
+
+bool I2sAdcSource::begin() {
+  i2s_config_t config = {};
+  config.mode = (i2s_mode_t)(I2S_MODE_MASTER | I2S_MODE_RX | I2S_MODE_ADC_BUILT_IN); // I2S тактує вбудований АЦП
+  config.sample_rate = SAMPLING_FREQ;
+  config.bits_per_sample = I2S_BITS_PER_SAMPLE_16BIT;
+  config.channel_format = I2S_CHANNEL_FMT_ONLY_LEFT;
+  config.communication_format = I2S_COMM_FORMAT_STAND_I2S;
+  config.intr_alloc_flags = ESP_INTR_FLAG_LEVEL1;
+  config.dma_buf_count = I2S_ADC_DMA_BLOCKS;
+  config.dma_buf_len = I2S_ADC_BLOCK;
+  config.use_apll = false;
+
+  if (i2s_driver_install(I2S_NUM_0, &config, I2S_ADC_DMA_BLOCKS, &events) != ESP_OK) return false;
+  if (i2s_set_adc_mode(ADC_UNIT_1, channel) != ESP_OK) return false;
+  adc1_config_channel_atten(channel, ADC_ATTEN_DB_11); // як у analogRead: повний діапазон 0–3.3 В
+  return i2s_adc_enable(I2S_NUM_0) == ESP_OK;
+}
+
+void I2sAdcSource::collectEvents() {
+  i2s_event_t event;
+  while (xQueueReceive(events, &event, 0) == pdTRUE) {
+    if (event.type == I2S_EVENT_RX_DONE) ready += I2S_ADC_BLOCK;
+    else if (event.type == I2S_EVENT_RX_Q_OVF) { // драйвер викинув найстаріший блок — ми не встигли його забрати
+      overrunCount++;
+      ready = (ready > I2S_ADC_BLOCK) ? ready - I2S_ADC_BLOCK : 0;
+    }
+  }
+}
+
+size_t I2sAdcSource::available() {
+  collectEvents();
+  return ready;
+}
+
+size_t I2sAdcSource::read(int *dst, size_t count, uint32_t timeoutMs) {
+  size_t done = 0;
+  while (done < count) {
+    size_t chunk = count - done;
+    if (chunk > I2S_ADC_BLOCK) chunk = I2S_ADC_BLOCK;
+    size_t bytes = 0;
+    i2s_read(I2S_NUM_0, raw, chunk * sizeof(uint16_t), &bytes, timeoutMs / portTICK_PERIOD_MS);
+    size_t got = bytes / sizeof(uint16_t);
+    if (got == 0) break; // тайм-аут
+    /*
+      В режимі ADC_BUILT_IN драйвер кладе 16-бітні зразки парами у 32-бітні слова
+      у зворотному порядку (1, 0, 3, 2, ...), тому міняємо сусідні зразки місцями.
+      Старші 4 біти кожного слова — номер каналу АЦП, значення — у молодших 12 бітах.
+    */
+    for (size_t i = 0; i + 1 < got; i += 2) {
+      dst[done + i] = raw[i + 1] & 0x0FFF;
+      dst[done + i + 1] = raw[i] & 0x0FFF;
+    }
+    if (got & 1) dst[done + got - 1] = raw[got - 1] & 0x0FFF;
+    done += got;
+  }
+  collectEvents();
+  ready = (ready > done) ? ready - done : 0;
+  return done;
+}
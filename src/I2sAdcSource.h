@@ -0,0 +1,34 @@
+// I2sAdcSource.h — безперервне захоплення звуку з вбудованого АЦП ESP32 через I2S і DMA.
+// АЦП сам оцифровує сигнал із частотою SAMPLING_FREQ у кільце DMA-блоків, а ядро лише
+// забирає готові блоки — замість 128 analogRead з delayMicroseconds між ними (~13 мс на кадр).
+#ifndef I2S_ADC_SOURCE_H
+#define I2S_ADC_SOURCE_H
+
+#include "SampleSource.h"
+
+#include <driver/adc.h>
+#include <driver/i2s.h>
+
+#define I2S_ADC_BLOCK 64      // зразків в одному DMA-блоці
+#define I2S_ADC_DMA_BLOCKS 16 // блоків у кільці (16 * 64 = 1024 зразки, ~100 мс при 10 кГц)
+
+class I2sAdcSource : public SampleSource {
+public:
+  explicit I2sAdcSource(adc1_channel_t channel) : channel(channel), events(NULL), ready(0), overrunCount(0) {}
+
+  bool begin() override;
+  size_t read(int *dst, size_t count, uint32_t timeoutMs) override;
+  size_t available() override;
+  uint32_t overruns() const override { return overrunCount; }
+
+private:
+  void collectEvents(); // зараховує заповнені блоки і переповнення з черги подій I2S
+
+  adc1_channel_t channel;
+  QueueHandle_t events; // черга подій драйвера I2S: по одній I2S_EVENT_RX_DONE на кожен заповнений блок
+  size_t ready;         // скільки захоплених зразків ще не прочитано
+  uint32_t overrunCount;
+  uint16_t raw[I2S_ADC_BLOCK];
+};
+
+#endif
@@ -0,0 +1,92 @@
+// LedGeometry.h — геометрія світильників: як координати пікселя перетворюються на номер LED у стрічці.
+// Таблиці — constexpr-дані (як і в SpectrumTables.h): обчислюються компілятором і лежать у флеш-пам’яті,
+// тож режими адресують пікселі координатами без жодних обчислень під час роботи — лише читання таблиці.
+// Більша матриця чи інше коло — це зміна параметрів шаблону (RING_*, SQUARE_*), а не коду режимів.
+#ifndef LED_GEOMETRY_H
+#define LED_GEOMETRY_H
+
+#include <array>
+#include <stdint.h>
+
+// Квадрати — матриці SQUARE_WIDTH x SQUARE_HEIGHT, стрічка прокладена "змійкою": парні рядки
+// зліва направо, непарні — справа наліво (0 1 2 3 / 7 6 5 4 / 8 9 10 11 / 15 14 13 12)
+#ifndef SQUARE_WIDTH
+#define SQUARE_WIDTH 4
+#endif
+#ifndef SQUARE_HEIGHT
+#define SQUARE_HEIGHT 4
+#endif
+
+#define RING_ANGLE_STEPS 64 // кутова роздільність таблиці "кут -> LED" (крок 5.625°)
+
+namespace geometry {
+
+// Номер LED пікселя (x, y) матриці W x H: x — стовпчик зліва, y — рядок від початку стрічки
+constexpr int matrixIndex(int w, bool serpentine, int x, int y) { return y * w + (serpentine && (y & 1) ? w - 1 - x : x); }
+
+// Номер LED кола з n LED на кроці position від першого LED за годинниковою стрілкою
+constexpr int ringIndex(int n, int offset, bool clockwise, int position) {
+  int p = ((position % n) + n) % n;
+  return (offset + (clockwise ? p : n - p)) % n;
+}
+
+template <int W, int H, bool SERPENTINE> constexpr std::array<uint8_t, W * H> makeMatrixTable() {
+  std::array<uint8_t, W * H> table{};
+  for (int y = 0; y < H; y++)
+    for (int x = 0; x < W; x++) table[y * W + x] = matrixIndex(W, SERPENTINE, x, y);
+  return table;
+}
+
+template <int N, int OFFSET, bool CLOCKWISE> constexpr std::array<uint8_t, N> makeRingPositions() {
+  std::array<uint8_t, N> table{};
+  for (int p = 0; p < N; p++) table[p] = ringIndex(N, OFFSET, CLOCKWISE, p);
+  return table;
+}
+
+template <int N, int OFFSET, bool CLOCKWISE> constexpr std::array<uint8_t, RING_ANGLE_STEPS> makeRingAngles() {
+  std::array<uint8_t, RING_ANGLE_STEPS> table{}; // найближчий LED до кожного кута
+  for (int a = 0; a < RING_ANGLE_STEPS; a++)
+    table[a] = ringIndex(N, OFFSET, CLOCKWISE, (2 * a * N + RING_ANGLE_STEPS) / (2 * RING_ANGLE_STEPS));
+  return table;
+}
+
+// Матриця W x H (SERPENTINE — стрічка "змійкою"): xy(x, y) — номер LED у стрічці
+template <int W, int H, bool SERPENTINE = true> struct Matrix {
+  static const int WIDTH = W;
+  static const int HEIGHT = H;
+  static const int COUNT = W * H;
+  static_assert(COUNT <= 256, "номери LED зберігаються в uint8_t");
+
+  static constexpr std::array<uint8_t, COUNT> table = makeMatrixTable<W, H, SERPENTINE>(); // [y * W + x] -> LED
+
+  static constexpr uint8_t xy(int x, int y) { return table[y * W + x]; }
+};
+
+// Коло з N LED: at(position) — крок по колу від "першого" LED за годинниковою стрілкою,
+// atAngle(angle) — кут у кроках RING_ANGLE_STEPS (0 — там, де перший LED). OFFSET — номер LED,
+// з якого починається відлік, CLOCKWISE — напрямок стрічки (для кіл, змонтованих інакше)
+template <int N, int OFFSET = 0, bool CLOCKWISE = true> struct Ring {
+  static const int COUNT = N;
+  static_assert(N <= 256, "номери LED зберігаються в uint8_t");
+
+  static constexpr std::array<uint8_t, N> positions = makeRingPositions<N, OFFSET, CLOCKWISE>();
+  static constexpr std::array<uint8_t, RING_ANGLE_STEPS> angles = makeRingAngles<N, OFFSET, CLOCKWISE>();
+
+  static constexpr uint8_t at(int position) { return positions[position]; } // position < N
+  static constexpr uint8_t atAngle(int angle) { return angles[angle & (RING_ANGLE_STEPS - 1)]; }
+};
+
+} // namespace geometry
+
+typedef geometry::Ring<16> BigRing;                               // велике коло (16 LED)
+typedef geometry::Ring<12> SmallRing;                             // мале коло (12 LED)
+typedef geometry::Matrix<SQUARE_WIDTH, SQUARE_HEIGHT> SquareGrid; // лівий і правий квадрати
+
+// Перевірка розкладки квадрата 4x4 (ті самі номери, що раніше були записані в режимах вручну)
+static_assert(SQUARE_WIDTH != 4 || SQUARE_HEIGHT != 4 ||
+                  (SquareGrid::xy(0, 0) == 0 && SquareGrid::xy(0, 1) == 7 && SquareGrid::xy(0, 2) == 8 &&
+                   SquareGrid::xy(0, 3) == 15 && SquareGrid::xy(2, 1) == 5 && SquareGrid::xy(3, 3) == 12),
+              "розкладка \"змійкою\" не збігається зі стрічкою квадрата");
+static_assert((RING_ANGLE_STEPS & (RING_ANGLE_STEPS - 1)) == 0, "RING_ANGLE_STEPS має бути степенем двійки");
+
+#endif
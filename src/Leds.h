@@ -0,0 +1,35 @@
+// Leds.h — піни і масиви світлодіодів (спільні для main.cpp і режимів у Renderers.cpp)
+#ifndef LEDS_H
+#define LEDS_H
+
+#include "LedGeometry.h"
+
+#include <FastLED.h> // бібліотека для керування адресними світлодіодами (наприклад, WS2812B)
+
+#define LED_PIN_16_CIRCLE 26 // пін для великого кола (16 LED)
+#define LED_PIN_12_CIRCLE 33 // пін для малого кола (12 LED)
+#define LED_PIN_L_SQUARE 25  // пін для великого кола (16 LED)
+#define LED_PIN_R_SQUARE 32  // пін для малого кола (12 LED)
+
+// Кількість LED — з геометрії світильників (LedGeometry.h)
+#define NUM_LEDS_16_CIRCLE BigRing::COUNT      // кількість LED у великому колі
+#define NUM_LEDS_12_CIRCLE SmallRing::COUNT    // кількість LED у малому колі
+#define NUM_LEDS_L_SQUARE SquareGrid::COUNT    // кількість LED у лівому квадраті
+#define NUM_LEDS_R_SQUARE SquareGrid::COUNT    // кількість LED у правому квадраті
+
+#define LED_STRIPS 4 // кількість стрічок
+
+// Вивід на стрічки (LedOutput): LED_OUTPUT_RMT — усі стрічки одночасно, по каналу RMT на стрічку,
+// і лише змінені; LED_OUTPUT_FASTLED — через FastLED.show() (наприклад, -D LED_OUTPUT=LED_OUTPUT_FASTLED)
+#define LED_OUTPUT_RMT 1
+#define LED_OUTPUT_FASTLED 2
+#ifndef LED_OUTPUT
+#define LED_OUTPUT LED_OUTPUT_RMT
+#endif
+
+extern CRGB leds_16_circle[NUM_LEDS_16_CIRCLE]; // масив для великого кола
+extern CRGB leds_12_circle[NUM_LEDS_12_CIRCLE]; // масив для малого кола
+extern CRGB leds_L_SQUARE[NUM_LEDS_L_SQUARE];   // масив для лівого квадрата
+extern CRGB leds_R_SQUARE[NUM_LEDS_R_SQUARE];   // масив для правого квадрата
+
+#endif
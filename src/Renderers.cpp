@@ -0,0 +1,180 @@
+#include "Renderers.h"
+
+#include "Leds.h"
+
+#include <Arduino.h>
+#include <algorithm>
+
+// Стан режимів між кадрами — статичні змінні: зберігають значення між викликами, але видимі
+// лише в цьому файлі
+static int small_circle = 0;           // для mode 2: поточний світлодіод малого кола
+static unsigned long current_time = 0; // для mode 2: коли він змінився востаннє
+
+static int bandLevel(const AudioFeatures &f) { // середній рівень усіх діапазонів (mode 6, 7)
+  double sum = 0;
+  for (int b = 0; b < f.bandCount; b++) sum += f.bands[b];
+  return f.bandCount > 0 ? sum / f.bandCount : 0;
+}
+
+// Дуга кола: count LED, починаючи з кроку from (номери LED — з constexpr-таблиці RING)
+template <typename RING> static void fillArc(CRGB *leds, int from, int count, const CRGB &color) {
+  for (int p = from; p < from + count; p++) leds[RING::at(p % RING::COUNT)] = color;
+}
+
+// Смуга в рядку y квадрата: count пікселів від лівого краю (або від правого, якщо fromRight)
+static void fillRow(CRGB *leds, int y, int count, bool fromRight, const CRGB &color) {
+  for (int i = 0; i < count; i++) leds[SquareGrid::xy(fromRight ? SquareGrid::WIDTH - 1 - i : i, y)] = color;
+}
+
+// clang-format off
+static void renderBandCircle(const FeatureFrame &frame) { // mode 1: велике коло (16 LED)
+  const AudioFeatures &f = frame.features;
+  int ampR = f.ampR, ampG = f.ampG, ampB = f.ampB; // амплітуди басів (R), середніх (G), високих (B)
+  int porigR = f.porigR, porigG = f.porigG, porigB = f.porigB;
+  if (ampR < porigR) leds_16_circle[BigRing::at(0)] = CRGB(255, 0, 0);
+  else if (ampR < porigR * 1.25) fillArc<BigRing>(leds_16_circle, 0, 2, CRGB(255, 0, 0));
+  else if (ampR < porigR * 1.5) fillArc<BigRing>(leds_16_circle, 0, 3, CRGB(255, 0, 0));
+  else if (ampR < porigR * 1.75) fillArc<BigRing>(leds_16_circle, 0, 4, CRGB(255, 0, 0));
+  else if (ampR < porigR * 2) fillArc<BigRing>(leds_16_circle, 0, 5, CRGB(255, 0, 0));
+  else fillArc<BigRing>(leds_16_circle, 0, 6, CRGB(255, 0, 0));
+
+  if (ampG < porigG) leds_16_circle[BigRing::at(6)] = CRGB(0, 255, 0);
+  else if (ampG < porigG * 1.3) fillArc<BigRing>(leds_16_circle, 6, 2, CRGB(0, 255, 0));
+  else if (ampG < porigG * 1.6) fillArc<BigRing>(leds_16_circle, 6, 3, CRGB(0, 255, 0));
+  else if (ampG < porigG * 1.9) fillArc<BigRing>(leds_16_circle, 6, 4, CRGB(0, 255, 0));
+  else fillArc<BigRing>(leds_16_circle, 6, 5, CRGB(0, 255, 0));
+
+  if (ampB < porigB) leds_16_circle[BigRing::at(11)] = CRGB(0, 0, 255);
+  else if (ampB < porigB * 1.3) fillArc<BigRing>(leds_16_circle, 11, 2, CRGB(0, 0, 255));
+  else if (ampB < porigB * 1.6) fillArc<BigRing>(leds_16_circle, 11, 3, CRGB(0, 0, 255));
+  else if (ampB < porigB * 1.9) fillArc<BigRing>(leds_16_circle, 11, 4, CRGB(0, 0, 255));
+  else fillArc<BigRing>(leds_16_circle, 11, 5, CRGB(0, 0, 255));
+}
+
+static void renderEnergySpinner(const FeatureFrame &frame) { // mode 2: мале коло (12 LED)
+  double avgEnergy = frame.features.avgEnergy;
+  if (small_circle < NUM_LEDS_12_CIRCLE);
+  else small_circle = 0;
+  leds_12_circle[SmallRing::at(small_circle)] = CRGB(0, 0, 255);
+  if (millis() - current_time > 1000000 / avgEnergy) {
+    if (renderTelemetry.due(TELEMETRY_SPINNER, millis())) { // крок кола — кожні кілька мс, друкуємо не частіше разу на секунду
+      float values[] = {(float)(millis() - current_time), (float)(1000000 / avgEnergy)};
+      renderTelemetry.log(TELEMETRY_SPINNER, millis(), values, 2);
+    }
+
+    small_circle++;
+    current_time = millis();
+  }
+}
+
+static void renderEnergyCircle(const FeatureFrame &frame) { // mode 3: велике коло (16)
+  double avgEnergy = frame.features.avgEnergy;
+       if (avgEnergy <= 250) fillArc<BigRing>(leds_16_circle, 0, 1, CRGB(255, 0, 170));
+  else if (avgEnergy <= 500) fillArc<BigRing>(leds_16_circle, 0, 2, CRGB(255, 0, 170));
+  else if (avgEnergy <= 750) fillArc<BigRing>(leds_16_circle, 0, 3, CRGB(255, 0, 170));
+  else if (avgEnergy <= 1000) fillArc<BigRing>(leds_16_circle, 0, 4, CRGB(255, 0, 170));
+  else if (avgEnergy <= 1250) fillArc<BigRing>(leds_16_circle, 0, 5, CRGB(255, 0, 170));
+  else if (avgEnergy <= 1500) fillArc<BigRing>(leds_16_circle, 0, 6, CRGB(255, 0, 170));
+  else if (avgEnergy <= 1750) fillArc<BigRing>(leds_16_circle, 0, 7, CRGB(255, 0, 170));
+  else if (avgEnergy <= 2000) fillArc<BigRing>(leds_16_circle, 0, 8, CRGB(255, 0, 170));
+  else if (avgEnergy <= 2250) fillArc<BigRing>(leds_16_circle, 0, 9, CRGB(255, 0, 170));
+  else if (avgEnergy <= 2500) fillArc<BigRing>(leds_16_circle, 0, 10, CRGB(255, 0, 170));
+  else if (avgEnergy <= 2750) fillArc<BigRing>(leds_16_circle, 0, 11, CRGB(255, 0, 170));
+  else if (avgEnergy <= 3000) fillArc<BigRing>(leds_16_circle, 0, 12, CRGB(255, 0, 170));
+  else if (avgEnergy <= 3250) fillArc<BigRing>(leds_16_circle, 0, 13, CRGB(255, 0, 170));
+  else if (avgEnergy <= 3500) fillArc<BigRing>(leds_16_circle, 0, 14, CRGB(255, 0, 170));
+  else if (avgEnergy <= 3750) fillArc<BigRing>(leds_16_circle, 0, 15, CRGB(255, 0, 170));
+  else if (avgEnergy <= 4000) fillArc<BigRing>(leds_16_circle, 0, 16, CRGB(255, 0, 170));
+
+ //     Serial.print(avgEnergy);
+}
+
+static void renderRawColumns(const FeatureFrame &frame) { // mode 4: лівий квадрат (vRawData, транспонований, без FFT, 3 стовпчики)
+  // 1. Спрощена обробка "сирих" даних із vRawData (середнє відхилення від середнього)
+  double rawAmplitude = frame.rawAmplitude;
+
+  // Масштабуємо амплітуду до 0–12 світлодіодів
+  int numLeds = map(rawAmplitude, 0, 500, 0, 13); // 0–12 LED, 500 — поріг чутливості
+  numLeds = constrain(numLeds, 0, 12);
+
+  // 2. Лівий квадрат: заповнення вертикальних стовпчиків знизу вгору (по SquareGrid::HEIGHT LED):
+  // перший стовпчик — червоний, другий — зелений, третій — синій (очищення і вивід — у задачі світлодіодів)
+  static const CRGB columnColors[] = {CRGB(255, 0, 0), CRGB(0, 255, 0), CRGB(0, 0, 255)};
+  for (int i = 0; i < numLeds; i++) {
+    int x = i / SquareGrid::HEIGHT;
+    leds_L_SQUARE[SquareGrid::xy(x, i % SquareGrid::HEIGHT)] = columnColors[x];
+  }
+}
+
+static void renderRawVsFiltered(const FeatureFrame &frame) { // mode 5: лівий квадрат (vRawData), правий квадрат (vReal, інвертований)
+  const AudioFeatures &f = frame.features;
+  int ampR = f.ampR, ampG = f.ampG, ampB = f.ampB; // амплітуди басів (R), середніх (G), високих (B)
+  // 1. Обробка "сирих" даних із vRawData для лівого квадрата (той самий аналіз, але без IIR)
+  BandAmps raw = frame.raw;
+  double rawAmpR = raw.r, rawAmpG = raw.g, rawAmpB = raw.b;
+
+  // 2. Масштабування амплітуд до кількості світлодіодів (0–4)
+  int numLedsR_raw = map(rawAmpR, 0, 255, 0, 5); // Баси для vRawData
+  int numLedsG_raw = map(rawAmpG, 0, 255, 0, 5); // Середні для vRawData
+  int numLedsB_raw = map(rawAmpB, 0, 255, 0, 5); // Високі для vRawData
+
+  int numLedsR = map(ampR, 0, 255, 0, 5); // Баси для vReal
+  int numLedsG = map(ampG, 0, 255, 0, 5); // Середні для vReal
+  int numLedsB = map(ampB, 0, 255, 0, 5); // Високі для vReal
+
+  // Обмежуємо до 4 світлодіодів
+  numLedsR_raw = constrain(numLedsR_raw, 0, 4);
+  numLedsG_raw = constrain(numLedsG_raw, 0, 4);
+  numLedsB_raw = constrain(numLedsB_raw, 0, 4);
+  numLedsR = constrain(numLedsR, 0, 4);
+  numLedsG = constrain(numLedsG, 0, 4);
+  numLedsB = constrain(numLedsB, 0, 4);
+
+  // 3. Лівий квадрат (vRawData): смуги в рядках 0–2 уздовж стрічки ("змійкою")
+  fillRow(leds_L_SQUARE, 0, numLedsR_raw, false, CRGB(255, 0, 0)); // Червоний (баси)
+  fillRow(leds_L_SQUARE, 1, numLedsG_raw, true, CRGB(0, 255, 0));  // Зелений (середні)
+  fillRow(leds_L_SQUARE, 2, numLedsB_raw, false, CRGB(0, 0, 255)); // Синій (високі)
+
+  // 4. Правий квадрат (vReal): ті самі смуги, інвертовані по вертикалі (рядки 3–1)
+  fillRow(leds_R_SQUARE, SquareGrid::HEIGHT - 1, numLedsR, false, CRGB(255, 0, 0)); // Червоний (баси)
+  fillRow(leds_R_SQUARE, SquareGrid::HEIGHT - 2, numLedsG, true, CRGB(0, 255, 0));  // Зелений (середні)
+  fillRow(leds_R_SQUARE, SquareGrid::HEIGHT - 3, numLedsB, false, CRGB(0, 0, 255)); // Синій (високі)
+}
+
+static void renderSquaresLevel(const FeatureFrame &frame) { // mode 6: обидва квадрати (32 LED)
+  const AudioFeatures &f = frame.features;
+  int totalAmp = bandLevel(f);
+  int brightness = map(totalAmp, 0, 600, 0, 255);
+  std::fill(leds_L_SQUARE + 0, leds_L_SQUARE + NUM_LEDS_L_SQUARE, CRGB(brightness, 0, 0));
+  std::fill(leds_R_SQUARE + 0, leds_R_SQUARE + NUM_LEDS_R_SQUARE, CRGB(0, brightness, 0));
+}
+
+static void renderAllLevel(const FeatureFrame &frame) { // mode 7: усе разом (28 + 32 LED)
+  const AudioFeatures &f = frame.features;
+  int totalAmp = bandLevel(f);
+  int brightness = map(totalAmp, 0, 600, 0, 255);
+  std::fill(leds_16_circle + 0, leds_16_circle + NUM_LEDS_16_CIRCLE, CRGB(brightness, 0, 0));
+  std::fill(leds_12_circle + 0, leds_12_circle + NUM_LEDS_12_CIRCLE, CRGB(0, brightness, 0));
+  std::fill(leds_L_SQUARE + 0, leds_L_SQUARE + NUM_LEDS_L_SQUARE, CRGB(brightness, 0, 0));
+  std::fill(leds_R_SQUARE + 0, leds_R_SQUARE + NUM_LEDS_R_SQUARE, CRGB(0, brightness, 0));
+}
+// clang-format on
+
+// Реєстр режимів: id збігається з позицією в масиві + 1, тож пошук режиму — просто індекс.
+// Новий ефект = нова функція і рядок тут; веб-маршрути /modeN, /modes і кнопки сторінки
+// створюються з цього масиву автоматично
+static const ModeDescriptor registry[] = {
+    {1, "Більше коло - 1", FEATURE_BANDS | FEATURE_ENERGY, renderBandCircle},
+    {2, "Менше коло", FEATURE_ENERGY, renderEnergySpinner},
+    {3, "Більше коло - 2", FEATURE_ENERGY, renderEnergyCircle},
+    {4, "Лівий квадрат - без FFT", FEATURE_RAW, renderRawColumns},
+    {5, "Два квадрати - \"сирі\" і оброблені дані", FEATURE_BANDS | FEATURE_RAW, renderRawVsFiltered},
+    {6, "Два квадрати - загальний рівень", FEATURE_BAND_LEVEL, renderSquaresLevel},
+    {7, "Усе разом - загальний рівень", FEATURE_BAND_LEVEL, renderAllLevel},
+};
+
+const ModeDescriptor *modes() { return registry; }
+
+int modeCount() { return sizeof(registry) / sizeof(registry[0]); }
+
+const ModeDescriptor *findMode(int id) { return id >= 1 && id <= modeCount() ? &registry[id - 1] : nullptr; }
@@ -0,0 +1,25 @@
+// Renderers.h — реєстр режимів світломузики.
+// Кожен режим описується один раз: номер, назва для веб-сторінки, які ознаки звуку йому потрібні
+// (FeatureFlags — від них залежить, що рахує задача аналізу) і функція, що малює кадр у масиви LED.
+#ifndef RENDERERS_H
+#define RENDERERS_H
+
+#include "AudioPipeline.h"
+#include "Telemetry.h"
+
+typedef void (*RenderFn)(const FeatureFrame &frame); // заповнює масиви leds_* (FastLED.show — у задачі світлодіодів)
+
+struct ModeDescriptor {
+  int id;             // номер режиму: маршрут /mode<id>
+  const char *name;   // підпис кнопки на веб-сторінці
+  unsigned features;  // FeatureFlags, потрібні режиму
+  RenderFn render;
+};
+
+const ModeDescriptor *modes(); // усі режими, id = 1..modeCount() по порядку
+int modeCount();
+const ModeDescriptor *findMode(int id); // nullptr — немає такого режиму
+
+extern TelemetryChannel renderTelemetry; // налагоджувальні записи задачі світлодіодів (визначено в main.cpp)
+
+#endif
@@ -0,0 +1,61 @@
+#include "RmtLedOutput.h"
+
+// Тривалості імпульсів WS2812B у тіках RMT (25 нс): "0" — 0.4 мкс високий + 0.85 мкс низький,
+// "1" — 0.8 мкс + 0.45 мкс; разом 1.25 мкс на біт (LED_BIT_NS)
+#define WS2812_T0H 16
+#define WS2812_T0L 34
+#define WS2812_T1H 32
+#define WS2812_T1L 18
+
+// Перетворює байти кадру в імпульси RMT (по 8 на байт, старший біт першим). Викликається драйвером
+// із переривання, коли в пам’яті каналу звільняється місце, тому лежить в IRAM
+static void IRAM_ATTR toWs2812Items(const void *src, rmt_item32_t *dest, size_t srcSize, size_t wantedNum,
+                                    size_t *translatedSize, size_t *itemNum) {
+  static const rmt_item32_t bit0 = {{{WS2812_T0H, 1, WS2812_T0L, 0}}};
+  static const rmt_item32_t bit1 = {{{WS2812_T1H, 1, WS2812_T1L, 0}}};
+  const uint8_t *bytes = (const uint8_t *)src;
+  size_t size = 0, num = 0;
+  while (size < srcSize && num + 8 <= wantedNum) {
+    for (int bit = 7; bit >= 0; bit--) dest[num++] = (bytes[size] >> bit) & 1 ? bit1 : bit0;
+    size++;
+  }
+  *translatedSize = size;
+  *itemNum = num;
+}
+
+bool RmtLedOutput::begin() {
+  if (stripTotal == 0) return true;
+  // 8 блоків пам’яті RMT (по 64 імпульси) ділимо порівну: канал i займає ще й блоки наступних
+  // каналів, тому при 4 стрічках це канали 0, 2, 4, 6 по 2 блоки — менше переривань на кадр
+  int blocks = LED_OUTPUT_MAX_STRIPS / stripTotal;
+  if (blocks > 4) blocks = 4;
+  for (int i = 0; i < stripTotal; i++) {
+    channels[i] = (rmt_channel_t)(i * blocks);
+    rmt_config_t config = RMT_DEFAULT_CONFIG_TX((gpio_num_t)strips[i].pin, channels[i]);
+    config.clk_div = RMT_LED_CLOCK_DIV;
+    config.mem_block_num = blocks;
+    if (rmt_config(&config) != ESP_OK) return false;
+    if (rmt_driver_install(channels[i], 0, 0) != ESP_OK) return false;
+    if (rmt_translator_init(channels[i], toWs2812Items) != ESP_OK) return false;
+  }
+  return true;
+}
+
+void RmtLedOutput::show(uint32_t mask) {
+  mask &= allStrips();
+  // Спершу запускаємо всі канали (rmt_write_sample без очікування) — стрічки передаються одночасно
+  for (int i = 0; i < stripTotal; i++) {
+    if (!(mask & (1u << i))) continue;
+    const LedStrip &s = strips[i];
+    for (int led = 0; led < s.count; led++) { // WS2812B чекає байти в порядку G, R, B
+      frames[i][3 * led] = scale(s.pixels[3 * led + 1], level);
+      frames[i][3 * led + 1] = scale(s.pixels[3 * led], level);
+      frames[i][3 * led + 2] = scale(s.pixels[3 * led + 2], level);
+    }
+    rmt_write_sample(channels[i], frames[i], s.count * 3, false);
+  }
+  // ...і лише потім чекаємо завершення — найдовшої стрічки, а не суми всіх
+  for (int i = 0; i < stripTotal; i++)
+    if (mask & (1u << i)) rmt_wait_tx_done(channels[i], portMAX_DELAY);
+  // Пауза скидання (LED_RESET_US) забезпечена тим, що наступний кадр — не раніше ніж за 50 мс
+}
@@ -0,0 +1,24 @@
+// RmtLedOutput.h — вивід на стрічки WS2812B через периферію RMT ESP32, по каналу на стрічку.
+// Усі канали запускаються один за одним без очікування і передають одночасно, тож кадр займає час
+// найдовшої стрічки, а не суму всіх (до LED_OUTPUT_MAX_STRIPS = 8 стрічок — стільки каналів RMT).
+// Біти WS2812B формує апаратура RMT, ядро лише перетворює байти в імпульси у перериванні (translator).
+#ifndef RMT_LED_OUTPUT_H
+#define RMT_LED_OUTPUT_H
+
+#include "LedOutput.h"
+
+#include <driver/rmt.h>
+
+#define RMT_LED_CLOCK_DIV 2 // 80 МГц / 2 = 40 МГц, тік 25 нс
+
+class RmtLedOutput : public LedOutput {
+public:
+  bool begin() override; // викликати на ядрі, де має працювати переривання RMT (не на ядрі Wi-Fi)
+  void show(uint32_t mask) override;
+
+private:
+  rmt_channel_t channels[LED_OUTPUT_MAX_STRIPS];
+  uint8_t frames[LED_OUTPUT_MAX_STRIPS][LED_STRIP_MAX_LEDS * 3]; // байти GRB з яскравістю — передаються з цих буферів
+};
+
+#endif
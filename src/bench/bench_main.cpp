@@ -0,0 +1,378 @@
+// bench_main.cpp — бенчмарк аудіоконвеєра на ПК (env:native), без плати.
+// Відтворює записані кадри по 128 зразків через AudioPipeline і друкує ns/кадр та кадрів/с.
+// Лише час: правильність кожного модуля перевіряють тести test/test_* (pio test -e native).
+//
+// Запуск:
+//   pio run -e native && .pio/build/native/program [файл_кадрів] [кількість_кадрів] [--max-ns N]
+//     файл_кадрів — текстовий файл зі значеннями АЦП (0–4095) через пробіл/новий рядок,
+//                   наприклад записаний із Serial, або WAV-файл (PCM 8/16 біт);
+//                   без файлу генерується синтетичний сигнал.
+//     --max-ns N  — повертає код 1, якщо конвеєр повільніший за N ns/кадр (для CI).
+#include "AudioPipeline.h"
+#include "FrameScheduler.h"
+#include "MockLedOutput.h"
+#include "Profiler.h"
+#include "SlidingWindow.h"
+#include "SyntheticSignal.h"
+#include "WavFileSource.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+typedef std::chrono::steady_clock Clock;
+
+static std::vector<int> loadSamples(const char *path) { // читаємо значення АЦП з текстового файлу
+  std::vector<int> samples;
+  FILE *file = fopen(path, "r");
+  if (!file) {
+    fprintf(stderr, "Не вдалося відкрити %s\n", path);
+    return samples;
+  }
+  int value;
+  while (fscanf(file, "%d", &value) == 1) samples.push_back(value);
+  fclose(file);
+  return samples;
+}
+
+static bool isWav(const char *path) {
+  size_t len = strlen(path);
+  return len > 4 && strcmp(path + len - 4, ".wav") == 0;
+}
+
+// Читаємо WAV кадрами через SampleSource (як конвеєр на платі) і міряємо, скільки часу ядро
+// витрачає на отримання кадру (що кадри йдуть без пропусків, перевіряє test_wav_source)
+static std::vector<int> loadWav(const char *path) {
+  std::vector<int> samples;
+  WavFileSource source(path);
+  if (!source.begin()) {
+    fprintf(stderr, "Не вдалося прочитати WAV %s\n", path);
+    return samples;
+  }
+  if (source.sampleRate() != SAMPLING_FREQ)
+    printf("увага: частота WAV %u Гц, а SAMPLING_FREQ %d Гц\n", source.sampleRate(), SAMPLING_FREQ);
+
+  int frame[SAMPLES];
+  Clock::time_point start = Clock::now();
+  while (source.read(frame, SAMPLES, 0) == SAMPLES) samples.insert(samples.end(), frame, frame + SAMPLES);
+  double readNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+  size_t frames = samples.size() / SAMPLES;
+
+  printf("WAV: %zu зразків, %zu кадрів\n", source.totalSamples(), frames);
+  if (frames > 0) {
+    printf("%-24s %10.0f ns/кадр (analogRead + delayMicroseconds, ядро зайняте)\n", "збір: блокуючий цикл", SAMPLES * 1e9 / SAMPLING_FREQ);
+    printf("%-24s %10.0f ns/кадр (копіювання готового блоку)\n", "збір: SampleSource", readNs / frames);
+  }
+  return samples;
+}
+
+// Віконування так, як його робила бібліотека arduinoFFT на кожному кадрі: cos() для кожної пари зразків
+static void trigHammingWindow(double *data) {
+  for (int i = 0; i < SAMPLES / 2; i++) {
+    double ratio = (double)i / (SAMPLES - 1);
+    double weight = 0.54 - 0.46 * cos(2 * M_PI * ratio);
+    data[i] *= weight;
+    data[SAMPLES - 1 - i] *= weight;
+  }
+}
+
+// Швидкість одного варіанта FFT (SPECTRUM_TYPE); windowed — кадри, уже підготовлені конвеєром
+// (DC, IIR, вікно Хеммінга). Точність кожного варіанта відносно double перевіряє test_spectrum
+template <typename T> static void benchBackend(const char *name, const std::vector<double> &windowed, long iterations, double &checksum) {
+  int frames = windowed.size() / SAMPLES;
+  RealFft<SAMPLES, T> fft;
+  double bins[SPECTRUM_BINS];
+  Clock::time_point start = Clock::now();
+  for (long i = 0; i < iterations; i++) {
+    fft.magnitudes(&windowed[(i % frames) * SAMPLES], bins);
+    checksum += bins[1];
+  }
+  double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / iterations;
+  printf("%-8s %10.0f ns/FFT\n", name, ns);
+}
+
+// "Сирі" діапазони mode 5 так, як їх рахували раніше: окреме FFT необроблених даних (для порівняння
+// часу з computeRawBands, який відновлює їх зі спектра фільтрованого сигналу без другого FFT)
+static BandAmps exactRawBands(const AudioPipeline &pipeline, const int *samples, RealFft<SAMPLES, SPECTRUM_TYPE> &fft) {
+  double raw[SAMPLES], bins[SPECTRUM_BINS], mean = 0;
+  for (int i = 0; i < SAMPLES; i++) mean += samples[i];
+  mean /= SAMPLES;
+  for (int i = 0; i < SAMPLES; i++) raw[i] = samples[i] - mean;
+  applyWindow<SAMPLES, SPECTRUM_WINDOW>(raw);
+  fft.magnitudes(raw, bins);
+  AudioFeatures out;
+  pipeline.bandsFromSpectrum(bins, out);
+  BandAmps amps = {out.bands[0], out.bands[out.bandCount / 2], out.bands[out.bandCount - 1]};
+  return amps;
+}
+
+// Час виводу кадру на strips стрічок по 16 LED (макет WS2812B): одночасно по каналу на стрічку
+// (RmtLedOutput) і по черзі (байти, які передає макет, перевіряє test_led_output)
+static void benchLedOutput() {
+  static uint8_t pixels[LED_OUTPUT_MAX_STRIPS][16 * 3];
+  printf("\nвивід на стрічки по 16 LED (WS2812B, мкс на кадр):\n");
+  for (int strips = 1; strips <= LED_OUTPUT_MAX_STRIPS; strips *= 2) {
+    MockLedOutput parallel(true), sequential(false);
+    for (int i = 0; i < strips; i++) {
+      for (int j = 0; j < 16 * 3; j++) pixels[i][j] = (uint8_t)(i * 31 + j * 7);
+      parallel.addStrip(i, pixels[i], 16);
+      sequential.addStrip(i, pixels[i], 16);
+    }
+    parallel.showAll();
+    sequential.showAll();
+    printf("%d стрічок: одночасно %5u, по черзі %5u\n", strips, (unsigned)parallel.lastWireUs(), (unsigned)sequential.lastWireUs());
+  }
+}
+
+// Деградація справді здешевлює аналіз: цикл задачі аналізу на секунду звуку з кроком hop за
+// замовчуванням (SAMPLES — більшого кроку не буває) на кожному рівні. Що кадрів стає удвічі менше,
+// перевіряє test_frame_scheduler; тут — скільки це часу ядра
+static void benchDegradation(const std::vector<int> &samples) {
+  std::vector<int> second(SAMPLING_FREQ);
+  for (size_t i = 0; i < second.size(); i++) second[i] = samples[i % samples.size()];
+  printf("\nдеградація аналізу (на секунду звуку):\n");
+  for (int level = 0; level <= DEGRADE_MAX_LEVEL; level++) {
+    AudioPipeline pipeline;
+    SlidingWindow window;
+    AnalysisThrottle throttle;
+    int frame[SAMPLES];
+    long analysed = 0;
+    double sum = 0, ns = 0;
+    for (int trial = 0; trial < 5; trial++) { // час — найкращий із 5 прогонів (менше шуму планувальника ОС)
+      analysed = 0;
+      Clock::time_point start = Clock::now();
+      for (int repeat = 0; repeat < 20; repeat++)
+        for (size_t at = 0; at + window.hop() <= second.size(); at += window.hop()) {
+          window.push(&second[at], window.hop());
+          if (!window.ready()) continue;
+          window.frame(frame);
+          if (!throttle.step(level, window.hop())) continue;
+          sum += pipeline.process(frame, std::min(throttle.newSamples(), SAMPLES)).avgEnergy;
+          analysed++;
+        }
+      double trialNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / 20;
+      if (trial == 0 || trialNs < ns) ns = trialNs;
+    }
+    printf("рівень деградації %d: %3ld кадрів аналізу на секунду звуку, %7.0f мкс (контроль %.0f)\n", level, analysed / 20,
+           ns / 1000, sum);
+  }
+}
+
+// Кроки 1–4 так, як їх рахували раніше: копія кадру з корекцією аномалій, сума, віднімання
+// середнього, IIR в окремий масив і копія назад (для порівняння часу зі злитим ядром preprocessFrame;
+// що результат збігається біт у біт, перевіряє test_preprocess)
+static void referencePreprocess(const int *samples, double *vReal) {
+  for (int i = 0; i < SAMPLES; i++) {
+    vReal[i] = samples[i];
+    if (vReal[i] < 0 || vReal[i] > ADC_MAX) vReal[i] = (i > 0) ? vReal[i - 1] : ADC_MID;
+  }
+  double mean = 0;
+  for (int i = 0; i < SAMPLES; i++) mean += vReal[i];
+  mean /= SAMPLES;
+  for (int i = 0; i < SAMPLES; i++) vReal[i] -= mean;
+  double filtered[SAMPLES];
+  filtered[0] = vReal[0];
+  for (int i = 1; i < SAMPLES; i++) filtered[i] = IIR_FEEDBACK * filtered[i - 1] + IIR_INPUT * vReal[i];
+  for (int i = 0; i < SAMPLES; i++) vReal[i] = filtered[i];
+}
+
+static void benchPreprocess(const std::vector<int> &frames, long iterations, double &checksum) {
+  size_t count = frames.size() / SAMPLES;
+  double out[SAMPLES];
+  Clock::time_point start = Clock::now();
+  for (long i = 0; i < iterations; i++) {
+    referencePreprocess(&frames[(i % count) * SAMPLES], out);
+    checksum += out[i % SAMPLES];
+  }
+  double referenceNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / iterations;
+  start = Clock::now();
+  for (long i = 0; i < iterations; i++) {
+    preprocessFrame(&frames[(i % count) * SAMPLES], out, SAMPLES);
+    checksum += out[i % SAMPLES];
+  }
+  double fusedNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / iterations;
+  printf("\nкроки 1–4 (корекція аномалій, DC, IIR; %zu кадрів):\n", count);
+  printf("%-24s %10.0f ns/кадр\n", "п’ять проходів", referenceNs);
+  printf("%-24s %10.0f ns/кадр\n", "злите ядро", fusedNs);
+}
+
+int main(int argc, char **argv) {
+  const char *path = NULL;
+  long iterations = 20000;
+  double maxNs = 0;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--max-ns") == 0 && i + 1 < argc) maxNs = atof(argv[++i]);
+    else if (!path && !isdigit((unsigned char)argv[i][0])) path = argv[i];
+    else iterations = atol(argv[i]);
+  }
+
+  std::vector<int> samples = !path ? synthSamples(256) : isWav(path) ? loadWav(path) : loadSamples(path);
+  int frames = samples.size() / SAMPLES;
+  if (frames == 0) {
+    fprintf(stderr, "Потрібно щонайменше %d зразків\n", SAMPLES);
+    return 2;
+  }
+
+  AudioPipeline pipeline;
+  double checksum = 0; // щоб компілятор не викинув обчислення
+  for (int i = 0; i < frames; i++) pipeline.process(&samples[i * SAMPLES]); // прогрів
+
+  Clock::time_point start = Clock::now();
+  for (long i = 0; i < iterations; i++) {
+    const AudioFeatures &f = pipeline.process(&samples[(i % frames) * SAMPLES]);
+    checksum += f.ampR + f.ampG + f.ampB + f.avgEnergy;
+  }
+  double pipelineNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / iterations;
+
+  start = Clock::now();
+  for (long i = 0; i < iterations; i++) {
+    pipeline.process(&samples[(i % frames) * SAMPLES]);
+    BandAmps raw = pipeline.computeRawBands(); // mode 5: додатковий аналіз "сирих" даних
+    checksum += raw.r + raw.g + raw.b;
+  }
+  double mode5Ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / iterations;
+
+  RealFft<SAMPLES, SPECTRUM_TYPE> rawFft;
+  start = Clock::now();
+  for (long i = 0; i < iterations; i++) {
+    pipeline.process(&samples[(i % frames) * SAMPLES]);
+    BandAmps exact = exactRawBands(pipeline, &samples[(i % frames) * SAMPLES], rawFft);
+    checksum += exact.r + exact.g + exact.b;
+  }
+  double mode5TwoFftNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / iterations;
+
+  printf("кадрів у записі: %d (%s), ітерацій: %ld\n", frames, path ? path : "синтетичний сигнал", iterations);
+  printf("діапазони (Гц):");
+  for (int b = 0; b < pipeline.bandMap().count(); b++) printf(" %.0f–%.0f", pipeline.bandMap().lowHz(b), pipeline.bandMap().highHz(b));
+  printf("\n");
+  printf("%-24s %10.0f ns/кадр %10.0f кадрів/с\n", "pipeline", pipelineNs, 1e9 / pipelineNs);
+  printf("%-24s %10.0f ns/кадр %10.0f кадрів/с\n", "pipeline + raw (mode 5)", mode5Ns, 1e9 / mode5Ns);
+  printf("%-24s %10.0f ns/кадр %10.0f кадрів/с (друге FFT)\n", "  raw окремим FFT", mode5TwoFftNs, 1e9 / mode5TwoFftNs);
+  printf("буфери DSP (DspArena): %zu байтів (межа %d), увесь конвеєр: %zu байтів\n", sizeof(DspArena), DSP_ARENA_MAX_BYTES,
+         sizeof(AudioPipeline));
+  // Ковзне вікно: скільки кадрів аналізу і часу ядра припадає на секунду звуку при різному кроці
+  printf("\nковзне вікно (на секунду звуку):\n");
+  for (int hop = SAMPLES; hop >= HOP_MIN; hop /= 2) {
+    SlidingWindow window(hop);
+    int frame[SAMPLES];
+    long analysed = 0;
+    size_t total = (size_t)frames * SAMPLES;
+    start = Clock::now();
+    for (size_t pos = 0; pos + hop <= total; pos += hop) {
+      window.push(&samples[pos], hop);
+      if (!window.ready()) continue;
+      window.frame(frame);
+      checksum += pipeline.process(frame, hop).ampR;
+      analysed++;
+    }
+    double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    double seconds = (double)total / SAMPLING_FREQ;
+    printf("hop %3d (перекриття %2d%%): %6.0f кадрів/с звуку, оновлення кожні %.1f мс, %8.0f мкс ядра/с звуку\n", hop,
+           SlidingWindow::overlapPercent(hop), analysed / seconds, 1000.0 * hop / SAMPLING_FREQ, ns / 1000 / seconds);
+  }
+
+  // Варіанти FFT: double / float / Q15 / Q31 на тих самих кадрах
+  std::vector<double> windowed;
+  for (int i = 0; i < frames; i++) {
+    pipeline.preprocess(&samples[i * SAMPLES]);
+    pipeline.computeSpectrum();
+    windowed.insert(windowed.end(), pipeline.timeDomain(), pipeline.timeDomain() + SAMPLES);
+  }
+  printf("\nваріант FFT (SPECTRUM_TYPE):\n");
+  benchBackend<double>("double", windowed, iterations, checksum);
+  benchBackend<float>("float", windowed, iterations, checksum);
+  benchBackend<int32_t>("Q31", windowed, iterations, checksum);
+  benchBackend<int16_t>("Q15", windowed, iterations, checksum);
+
+  // Герцель проти FFT: точка, де повне FFT стає дешевшим
+  RealFft<SAMPLES, SPECTRUM_TYPE> fft;
+  double fftBins[SPECTRUM_BINS];
+  start = Clock::now();
+  for (long i = 0; i < iterations; i++) {
+    fft.magnitudes(&windowed[(i % frames) * SAMPLES], fftBins);
+    checksum += fftBins[1];
+  }
+  double fftNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / iterations;
+  printf("\nГерцель проти FFT (%d бінів за %.0f ns):\n", SPECTRUM_BINS, fftNs);
+  int crossover = 0;
+  static const int binCounts[] = {1, 2, 4, 8, 16, 32, SPECTRUM_BINS};
+  for (int bins : binCounts) {
+    int ks[SPECTRUM_BINS];
+    double mags[SPECTRUM_BINS];
+    for (int k = 0; k < bins; k++) ks[k] = k * (SPECTRUM_BINS - 1) / bins;
+    start = Clock::now();
+    for (long i = 0; i < iterations; i++) {
+      Goertzel<SAMPLES, SPECTRUM_TYPE>::magnitudes(&windowed[(i % frames) * SAMPLES], ks, bins, mags);
+      checksum += mags[0];
+    }
+    double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / iterations;
+    if (ns < fftNs) crossover = bins;
+    printf("%3d бінів: %8.0f ns (%s)\n", bins, ns, ns < fftNs ? "Герцель дешевший" : "FFT дешевше");
+  }
+  printf("Герцель вигідний до %d бінів (GOERTZEL_MAX_BINS = %d)\n", crossover, GOERTZEL_MAX_BINS);
+
+  // Вартість кадру залежно від того, що потрібно режиму (AudioPipeline::setFeatures)
+  static const struct {
+    const char *name;
+    unsigned features;
+  } plans[] = {
+      {"діапазони (mode 1, 5)", FEATURE_BANDS | FEATURE_ENERGY},
+      {"рівень (mode 6, 7)", FEATURE_BAND_LEVEL},
+      {"енергія (mode 2, 3)", FEATURE_ENERGY},
+      {"без спектра (mode 4)", FEATURE_RAW},
+  };
+  static const char *methodNames[] = {"без спектра", "Герцель", "FFT"};
+  printf("\nаналіз за потребами режиму:\n");
+  for (const auto &plan : plans) {
+    pipeline.setFeatures(plan.features);
+    start = Clock::now();
+    for (long i = 0; i < iterations; i++) checksum += pipeline.process(&samples[(i % frames) * SAMPLES]).avgEnergy;
+    double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / iterations;
+    printf("%-24s %10.0f ns/кадр (%s)\n", plan.name, ns, methodNames[pipeline.spectrumMethod()]);
+  }
+  pipeline.setFeatures(FEATURE_ALL);
+
+  // Віконування: cos() на кожному кадрі проти constexpr-таблиці
+  std::vector<double> source(samples.begin(), samples.begin() + SAMPLES), weighted(SAMPLES); // щоразу вікно до свіжої копії
+  start = Clock::now();
+  for (long i = 0; i < iterations; i++) {
+    std::copy(source.begin(), source.end(), weighted.begin());
+    trigHammingWindow(weighted.data());
+    checksum += weighted[i % SAMPLES];
+  }
+  double trigNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / iterations;
+  start = Clock::now();
+  for (long i = 0; i < iterations; i++) {
+    std::copy(source.begin(), source.end(), weighted.begin());
+    applyWindow<SAMPLES, WINDOW_HAMMING>(weighted.data());
+    checksum += weighted[i % SAMPLES];
+  }
+  double tableNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / iterations;
+  printf("\nвіконування (Хеммінг, %d зразків):\n", SAMPLES);
+  printf("%-24s %10.0f ns/кадр\n", "cos() на кожному кадрі", trigNs);
+  printf("%-24s %10.0f ns/кадр\n", "constexpr-таблиця", tableNs);
+
+  benchPreprocess(samples, iterations, checksum);
+  benchLedOutput();
+  benchDegradation(samples);
+
+#if AUDIO_PROFILING
+  // Час етапів за всі прогони вище (гістограма з кошиками по чверті октави: p99 — з точністю до кошика)
+  static char report[2048];
+  Profiler::report(report, sizeof(report));
+  printf("\nчас етапів (AUDIO_PROFILING):\n%s", report);
+#endif
+
+  printf("checksum: %.3f\n", checksum);
+
+  if (maxNs > 0 && pipelineNs > maxNs) {
+    fprintf(stderr, "РЕГРЕСІЯ: %.0f ns/кадр > %.0f ns/кадр\n", pipelineNs, maxNs);
+    return 1;
+  }
+  return 0;
+}
@@ -20,42 +20,110 @@
   світлодіодами без затримок.
 */
 #include "../config.h"
-#include "arduinoFFT.h" // бібліотека для виконання швидкого перетворення Фур'є (FFT), - аналізуємо звукові частоти
-#include <FastLED.h>    // бібліотека для керування адресними світлодіодами (наприклад, WS2812B)
+#include "AudioPipeline.h"  // апаратно-незалежний ланцюжок обробки звуку (DC, IIR, FFT, діапазони, згладжування) з lib/AudioPipeline
+#include "Backoff.h"        // наростаюча затримка між спробами підключення до Wi-Fi
+#include "FastLedOutput.h"  // вивід на стрічки через FastLED
+#include "FeatureStream.h"  // стислі кадри ознак для WebSocket /ws
+#include "FrameMailbox.h"   // найсвіжіший кадр ознак між задачею аналізу і задачею світлодіодів
+#include "FrameScheduler.h" // темп кадрів світлодіодів за дедлайнами
+#include "I2sAdcSource.h"   // безперервне захоплення звуку з АЦП через I2S/DMA
+#include "Leds.h"           // піни і масиви світлодіодів
+#include "ParamStore.h"     // параметри, що змінюються через /api/state (версійований блок)
+#include "Profiler.h"       // час етапів кадру (лише з -D AUDIO_PROFILING=1)
+#include "RmtLedOutput.h"   // вивід на всі стрічки одночасно через RMT
+#include "Renderers.h"      // реєстр режимів: назви, потрібні ознаки і функції малювання
+#include "SlidingWindow.h"  // ковзне вікно аналізу з кроком hop
+#include "SpscQueue.h"      // черги трансляції і подій WebSocket
+#include "StripTracker.h"   // які стрічки змінились з останнього виводу
+#include "index_html_gz.h"  // сторінка керування, стиснена gzip (генерує tools/embed_ui.py)
+#include "Telemetry.h"      // налагоджувальні записи без Serial у задачах реального часу
 #include <WiFi.h>
 
-#define SAMPLES 128         // кількість зразків для FFT (128 точок даних для аналізу сигналу)
-#define SAMPLING_FREQ 10000 // частота дискретизації (10 кГц), тобто 10 000 зразків за секунду
-
-#define LED_PIN_16_CIRCLE 26 // пін для великого кола (16 LED)
-#define LED_PIN_12_CIRCLE 33 // пін для малого кола (12 LED)
-#define LED_PIN_L_SQUARE 25  // пін для великого кола (16 LED)
-#define LED_PIN_R_SQUARE 32  // пін для малого кола (12 LED)
-
-#define NUM_LEDS_16_CIRCLE 16 // кількість LED у великому колі
-#define NUM_LEDS_12_CIRCLE 12 // кількість LED у малому колі
-#define NUM_LEDS_L_SQUARE 16  // кількість LED у лівому квадраті
-#define NUM_LEDS_R_SQUARE 16  // кількість LED у правому квадраті
-
 const char *ssid = WIFI_SSID;
 const char *password = WIFI_PASSWORD;
 
+// Wi-Fi піднімається у фоні: аналіз і світлодіоди стартують одразу, не чекаючи точки доступу.
+// Події Wi-Fi (задача системи) лише змінюють wifiUp, а підключення, повторні спроби з Backoff
+// і запуск веб-сервера — у webServerTask
+std::atomic<bool> wifiUp(false);
+Backoff wifiBackoff;
+std::atomic<uint32_t> firstFrameUs(0); // мкс від старту до першого кадру світлодіодів (0 — ще не було)
+
 CRGB leds_16_circle[NUM_LEDS_16_CIRCLE]; // масив для великого кола
 CRGB leds_12_circle[NUM_LEDS_12_CIRCLE]; // масив для малого кола
 CRGB leds_L_SQUARE[NUM_LEDS_L_SQUARE];   // масив для лівого квадрата
 CRGB leds_R_SQUARE[NUM_LEDS_R_SQUARE];   // масив для правого квадрата
+StripTracker<LED_STRIPS> strips;         // хеші стрічок: кадр без змін не передається
+#if LED_OUTPUT == LED_OUTPUT_RMT
+RmtLedOutput ledOutput;
+#else
+FastLedOutput ledOutput;
+#endif
+LedOutput &output = ledOutput; // режими малюють у масиви, а на стрічки їх передає будь-яка реалізація LedOutput
 
 AsyncWebServer server(80); // об’єкт асинхронного веб-сервера, що слухає порт 80 (стандартний HTTP-порт)
-
-ArduinoFFT<double> FFT = ArduinoFFT<double>(); // об’єкт FFT для аналізу сигналу
-double vRawData[SAMPLES];                      // масив для зберігання "сирих" даних для порівняння у світломузиці
-double vReal[SAMPLES];                         // масив для зберігання реальних частин сигналу
-double vImag[SAMPLES];                         // масив для зберігання уявних частин сигналу
-volatile int mode = 2;                         // поточний режим роботи (встановлюється віддалено через веб-сервер);
-                                               // volatile, бо використовується у кількох задачах
-
-int ampR, ampG, ampB; // для зберігання амплітуд частотних діапазонів: басів (R), середніх частот (G), високих частот (B), для mode 1
-int small_circle = 0; // для mode 2
+AsyncWebSocket ws("/ws");  // трансляція ознак звуку в браузер (двійкові кадри FeatureStream)
+
+AudioPipeline pipeline;                  // обробка звуку: від зразків мікрофона до амплітуд басів/середніх/високих
+I2sAdcSource adcSource(ADC1_CHANNEL_6); // мікрофон на GPIO34 (канал 6 АЦП1)
+SampleSource &source = adcSource;       // конвеєр працює з будь-яким джерелом зразків
+// Буфери збору кадру — в арені конвеєра (DspArena), разом з усіма робочими буферами аналізу
+SlidingWindow &window = pipeline.workspace().window; // ковзне вікно: останні SAMPLES зразків, новий кадр кожні hop зразків
+int *const block = pipeline.workspace().block;       // нові зразки за один крок (hop)
+int *const frame = pipeline.workspace().frame;       // вікно з SAMPLES зразків для аналізу
+// Режим, підсилення, пороги, згладжування, яскравість, крок аналізу і частота кадрів — один блок з версією.
+// Пише веб-сервер (/modeN, /hop, /fps, /api/state), задачі аналізу і світлодіодів перечитують його,
+// лише коли версія змінилась. hop: 128 — без перекриття, 64 — перекриття 50%, 32 — 75%
+ParamStore params;
+std::atomic<int> degradeLevel(0); // рівень деградації від планувальника кадрів: 0 — повна якість аналізу
+AnalysisThrottle throttle;         // які кроки hop аналізувати за цим рівнем (лише задача аналізу)
+
+#define FEATURE_READ_ATTEMPTS 4 // спроб узгодженої копії кадру ознак за кадр світлодіодів (далі — кадр втрачено)
+#define ANALYSIS_STACK 6144   // байтів стека задачі аналізу: буфери кадру — в DspArena, не на стеку
+#define ANALYSIS_CORE 1       // ядро задачі аналізу звуку
+#define RENDER_CORE 1         // ядро задачі світлодіодів: на ядрі 0 переривання Wi-Fi заважали б виводу RMT
+
+// Аналіз (писач) і світлодіоди (читач) працюють кожен у своєму темпі: аналіз — кожні hop зразків
+// (до ~312 кадрів/с при HOP_MIN), світлодіоди — RENDER_FPS разів на секунду, і показують лише найсвіжіший
+// кадр. Тож замість черги — одна комірка (FrameMailbox): кожен новий кадр замінює ще не показаний, а
+// черга з кількох кадрів при малому hop переповнювалась би постійно
+FrameMailbox<FeatureFrame> latestFrame;
+TaskHandle_t analysisHandle = NULL; // для звіту про запас стека
+TaskHandle_t renderHandle = NULL;
+FrameScheduler scheduler; // дедлайни кадрів світлодіодів, перевищення і рівень деградації
+
+// Налагоджувальний вивід: задачі аналізу і світлодіодів лише кладуть двійкові записи у свої черги
+// (кожна — у свою, SPSC), а друкує їх у Serial telemetryTask з низьким пріоритетом на ядрі 0.
+// Повільний UART більше не зупиняє аналіз звуку: якщо черга повна, запис просто відкидається
+TelemetryChannel analysisTelemetry; // записи задачі аналізу
+TelemetryChannel renderTelemetry;   // записи задачі світлодіодів і режимів (Renderers.cpp)
+#define TELEMETRY_CORE 0            // ядро задачі виводу телеметрії (разом із веб-сервером)
+
+// Трансляція ознак через WebSocket. Задача світлодіодів лише кладе показаний кадр у streamQueue (якщо
+// є клієнти), а кодує й надсилає webServerTask — кожному клієнту з його частотою. Події WebSocket
+// приходять із задачі AsyncTCP і теж передаються через чергу, тож таблицю клієнтів змінює лише webServerTask
+#define STREAM_MAX_CLIENTS 4
+
+struct StreamEvent {
+  enum { CONNECT, DISCONNECT, RATE } type;
+  uint32_t client;
+  int fps;
+};
+
+struct StreamClient {
+  bool used;
+  uint32_t id;
+  FeatureStreamEncoder encoder; // свій для кожного клієнта: різниця — від того, що клієнт отримав
+  uint32_t periodMs;
+  uint32_t lastMs;   // коли востаннє настав час кадру
+  uint32_t sentFrame; // номер останнього надісланого кадру аналізу (той самий кадр двічі не надсилаємо)
+};
+
+SpscQueue<FeatureFrame, 4> streamQueue;  // показані кадри для трансляції (повна — кадр відкидається)
+SpscQueue<StreamEvent, 16> streamEvents; // події WebSocket: від задачі AsyncTCP до webServerTask
+StreamClient streamClients[STREAM_MAX_CLIENTS];
+std::atomic<int> streamClientCount(0);  // задача світлодіодів не кладе кадри, якщо дивитись нікому
+std::atomic<uint32_t> streamDropped(0); // кадри, не надіслані клієнтам, які не встигали
 
 // У скетчі використовуємо багатозадачність FreeRTOS, розподіляючи на різні ядра
 // ESP32-WROOM-32D роботу веб-сервера (ядро 0) і обробку звуку/світла (ядро 1)
@@ -79,6 +147,114 @@ int small_circle = 0; // для mode 2
   Забезпечує реакцію в реальному часі (це важливо для світломузики).
 */
 
+#define API_BODY_MAX 512 // найбільше тіло PATCH /api/state
+
+static void sendState(AsyncWebServerRequest *request, int status, const LightParams &p) {
+  char json[384];
+  lightParamsToJson(p, json, sizeof(json));
+  AsyncWebServerResponse *response = request->beginResponse(status, "application/json", json);
+  response->addHeader("Access-Control-Allow-Origin", "*");
+  request->send(response);
+}
+
+static void sendError(AsyncWebServerRequest *request, int status, const char *message) {
+  String json = "{\"error\":\"";
+  json += message; // повідомлення з patchLightParams — без лапок
+  json += "\"}";
+  AsyncWebServerResponse *response = request->beginResponse(status, "application/json; charset=utf-8", json);
+  response->addHeader("Access-Control-Allow-Origin", "*");
+  request->send(response);
+}
+
+static void maintainWifi(uint32_t now) { // викликається з webServerTask кожні ~10 мс
+  static bool wasUp = false, serverStarted = false;
+  bool up = wifiUp;
+  if (up && !wasUp) {
+    if (!serverStarted) {
+      server.begin(); // запускаємо веб-сервер
+      serverStarted = true;
+    }
+    Serial.print("Wi-Fi підключено через ");
+    Serial.print(now);
+    Serial.print(" мс від старту (повторних спроб: ");
+    Serial.print(wifiBackoff.attempts());
+    Serial.print("), IP-адреса: ");
+    Serial.println(WiFi.localIP().toString());
+  } else if (!up && wasUp) {
+    Serial.println("Wi-Fi втрачено — повторне підключення з наростаючою затримкою");
+    wifiBackoff.start(now);
+  } else if (!up && wifiBackoff.due(now)) { // спроба не вдалась — наступна вдвічі пізніше (до BACKOFF_MAX_MS)
+    wifiBackoff.attempt(now);
+    WiFi.disconnect();
+    WiFi.begin(ssid, password);
+  }
+  wasUp = up;
+}
+
+static void applyStreamEvent(const StreamEvent &event) {
+  for (int i = 0; i < STREAM_MAX_CLIENTS; i++) {
+    StreamClient &c = streamClients[i];
+    if (event.type == StreamEvent::CONNECT && !c.used) { // новий клієнт почне з ключового кадру
+      c.used = true;
+      c.id = event.client;
+      c.encoder.reset();
+      c.periodMs = 1000 / FeatureStreamEncoder::clampFps(event.fps);
+      c.lastMs = millis() - c.periodMs;
+      c.sentFrame = UINT32_MAX;
+      return;
+    }
+    if (c.used && c.id == event.client) {
+      if (event.type == StreamEvent::DISCONNECT) c.used = false;
+      else if (event.type == StreamEvent::RATE) c.periodMs = 1000 / FeatureStreamEncoder::clampFps(event.fps);
+      return;
+    }
+  }
+  if (event.type == StreamEvent::CONNECT) { // усі місця зайняті — закриваємо з’єднання
+    AsyncWebSocketClient *client = ws.client(event.client);
+    if (client) client->close();
+  }
+}
+
+static void streamFeatures(uint32_t now) { // викликається з webServerTask кожні ~10 мс
+  static FeatureFrame latest;
+  static bool haveFrame = false;
+  static uint32_t lastCleanup = 0;
+
+  StreamEvent event;
+  while (streamEvents.pop(event)) applyStreamEvent(event);
+  int count = 0;
+  for (int i = 0; i < STREAM_MAX_CLIENTS; i++) count += streamClients[i].used;
+  streamClientCount = count;
+  FeatureFrame next;
+  while (streamQueue.pop(next)) {
+    latest = next;
+    haveFrame = true;
+  }
+  if (now - lastCleanup >= 1000) { // закриті з’єднання бібліотека прибирає лише за запитом
+    ws.cleanupClients(STREAM_MAX_CLIENTS);
+    lastCleanup = now;
+  }
+  if (!haveFrame) return;
+
+  uint8_t buffer[STREAM_FRAME_MAX];
+  for (int i = 0; i < STREAM_MAX_CLIENTS; i++) {
+    StreamClient &c = streamClients[i];
+    if (!c.used || now - c.lastMs < c.periodMs || c.sentFrame == latest.sequence) continue;
+    c.lastMs = now;
+    AsyncWebSocketClient *client = ws.client(c.id);
+    if (!client) continue;
+    // Клієнт не встигає (черга відправлення повна) — кадр пропускаємо, а не ставимо в чергу:
+    // наступний буде свіжим, а різниця рахуватиметься від останнього справді надісланого
+    if (!client->canSend()) {
+      streamDropped++;
+      continue;
+    }
+    size_t size = c.encoder.encode(latest, buffer);
+    client->binary(buffer, size);
+    c.sentFrame = latest.sequence;
+  }
+}
+
 void webServerTask(void *pvParameters) { // завдання для веб-сервера, що працює на ядрі 0
   /*
     Використовуємо Callback (зворотний виклик) — це функція, яка передається як
@@ -91,58 +267,139 @@ void webServerTask(void *pvParameters) { // завдання для веб-се
 
     Нижче [](AsyncWebServerRequest *request) { ... } — це callback.
     Він передається методу server.on і викликається, коли клієнт надсилає
-    GET-запит на /mode1. Усередині callback: mode = 1 змінює режим.
+    GET-запит на /mode1. Усередині callback: p.mode = id змінює режим у блоці params.
       request->send(...) відправляє відповідь клієнту.
     Бібліотека ESPAsyncWebServer працює на основі подій.
     Коли надходить запит, вона викликає зареєстрований callback, передаючи йому
-    об’єкт request із деталями запиту. У нас є три callbacks - для /mode1,
-    /mode2, /mode3. Переваги: не блокуємо ядро 0, дозволяючи йому виконувати
+    об’єкт request із деталями запиту. Callbacks для /mode1../modeN створюються
+    в циклі з реєстру режимів (Renderers.cpp). Переваги: не блокуємо ядро 0, дозволяючи йому виконувати
     інші задачі (наприклад, цикл у webServerTask). Без "ручного" опитування і
     швидко реагуємо на запити.
   */
 
-  server.on("/mode1", HTTP_GET, [](AsyncWebServerRequest *request) {
-    mode = 1;
-    AsyncWebServerResponse *response = request->beginResponse(200, "text/plain", "OK");
-    response->addHeader("Access-Control-Allow-Origin", "*"); // Додаємо CORS-заголовок
-    request->send(response);
-  });
-  server.on("/mode2", HTTP_GET, [](AsyncWebServerRequest *request) {
-    mode = 2;
-    AsyncWebServerResponse *response = request->beginResponse(200, "text/plain", "OK");
-    response->addHeader("Access-Control-Allow-Origin", "*");
+  // Сторінка керування: віддається стисненою прямо з флеш-пам’яті (без копії в RAM). Браузер щоразу
+  // перепитує (no-cache), але з ETag: поки прошивка та сама, відповідь — 304 без тіла
+  server.on("/", HTTP_GET, [](AsyncWebServerRequest *request) {
+    if (request->hasHeader("If-None-Match") && request->getHeader("If-None-Match")->value() == INDEX_HTML_ETAG) {
+      AsyncWebServerResponse *response = request->beginResponse(304);
+      response->addHeader("ETag", INDEX_HTML_ETAG);
+      response->addHeader("Cache-Control", "no-cache");
+      request->send(response);
+      return;
+    }
+    AsyncWebServerResponse *response = request->beginResponse_P(200, "text/html; charset=utf-8", INDEX_HTML_GZ, INDEX_HTML_GZ_SIZE);
+    response->addHeader("Content-Encoding", "gzip");
+    response->addHeader("ETag", INDEX_HTML_ETAG);
+    response->addHeader("Cache-Control", "no-cache");
     request->send(response);
   });
-  server.on("/mode3", HTTP_GET, [](AsyncWebServerRequest *request) {
-    mode = 3;
-    AsyncWebServerResponse *response = request->beginResponse(200, "text/plain", "OK");
+
+  for (int i = 0; i < modeCount(); i++) { // маршрути /mode1../modeN — з реєстру режимів
+    int id = modes()[i].id;
+    server.on(("/mode" + String(id)).c_str(), HTTP_GET, [id](AsyncWebServerRequest *request) {
+      params.update([id](LightParams &p) {
+        p.mode = id;
+        return true;
+      });
+      AsyncWebServerResponse *response = request->beginResponse(200, "text/plain", "OK");
+      response->addHeader("Access-Control-Allow-Origin", "*"); // Додаємо CORS-заголовок
+      request->send(response);
+    });
+  }
+  server.on("/modes", HTTP_GET, [](AsyncWebServerRequest *request) { // список режимів для кнопок сторінки (JSON)
+    String json = "[";
+    for (int i = 0; i < modeCount(); i++) {
+      if (i > 0) json += ",";
+      json += "{\"id\":" + String(modes()[i].id) + ",\"name\":\"";
+      for (const char *c = modes()[i].name; *c; c++) { // екрануємо лапки в назві
+        if (*c == '"' || *c == '\\') json += '\\';
+        json += *c;
+      }
+      json += "\"}";
+    }
+    json += "]";
+    AsyncWebServerResponse *response = request->beginResponse(200, "application/json", json);
     response->addHeader("Access-Control-Allow-Origin", "*");
     request->send(response);
   });
-  server.on("/mode4", HTTP_GET, [](AsyncWebServerRequest *request) {
-    mode = 4;
-    AsyncWebServerResponse *response = request->beginResponse(200, "text/plain", "OK");
+  server.on("/hop", HTTP_GET, [](AsyncWebServerRequest *request) { // крок ковзного вікна: /hop?n=32 (без n — лише показати)
+    if (request->hasParam("n")) {
+      int hop = SlidingWindow::clampHop(request->getParam("n")->value().toInt()); // HOP_MIN..SAMPLES
+      params.update([hop](LightParams &p) {
+        p.hop = hop;
+        return true;
+      });
+    }
+    int hop = params.read().hop;
+    String text = "hop=" + String(hop) + " overlap=" + String(SlidingWindow::overlapPercent(hop)) + "% samples=" + String(SAMPLES);
+    AsyncWebServerResponse *response = request->beginResponse(200, "text/plain", text);
     response->addHeader("Access-Control-Allow-Origin", "*");
     request->send(response);
   });
-  server.on("/mode5", HTTP_GET, [](AsyncWebServerRequest *request) {
-    mode = 5;
-    AsyncWebServerResponse *response = request->beginResponse(200, "text/plain", "OK");
+  server.on("/fps", HTTP_GET, [](AsyncWebServerRequest *request) { // частота кадрів світлодіодів: /fps?n=30
+    if (request->hasParam("n")) {
+      int fps = FrameScheduler::clampFps(request->getParam("n")->value().toInt());
+      params.update([fps](LightParams &p) {
+        p.fps = fps;
+        return true;
+      });
+    }
+    String text = "fps=" + String(params.read().fps) + " overruns=" + String(scheduler.overruns()) +
+                  " skipped=" + String(scheduler.skippedPeriods()) + " level=" + String(scheduler.level());
+    AsyncWebServerResponse *response = request->beginResponse(200, "text/plain", text);
     response->addHeader("Access-Control-Allow-Origin", "*");
     request->send(response);
   });
-  server.on("/mode6", HTTP_GET, [](AsyncWebServerRequest *request) {
-    mode = 6;
-    AsyncWebServerResponse *response = request->beginResponse(200, "text/plain", "OK");
+  // /api/state: GET — увесь блок параметрів JSON-ом, PATCH — змінює передані поля (решта як була).
+  // Зміни застосовуються цілим блоком з новою версією; з "version" у тілі PATCH спрацює, лише якщо
+  // стан не змінився з моменту читання (інакше 409)
+  server.on("/api/state", HTTP_GET, [](AsyncWebServerRequest *request) { sendState(request, 200, params.read()); });
+  server.on(
+      "/api/state", HTTP_PATCH,
+      [](AsyncWebServerRequest *request) { // викликається після тіла; без тіла — помилка
+        if (request->contentLength() == 0) sendError(request, 400, "порожнє тіло запиту");
+      },
+      nullptr,
+      [](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total) {
+        if (index != 0 || len != total || total > API_BODY_MAX) { // тіло — одним шматком (параметри — кілька сотень байтів)
+          if (index == 0) sendError(request, 413, "тіло запиту завелике");
+          return;
+        }
+        char error[96];
+        int status = 200;
+        bool changed = params.update([&](LightParams &p) {
+          PatchResult result = patchLightParams((const char *)data, len, p, error, sizeof(error));
+          if (result != PATCH_OK) {
+            status = result == PATCH_CONFLICT ? 409 : 400;
+            return false;
+          }
+          if (!findMode(p.mode)) {
+            snprintf(error, sizeof(error), "немає режиму %d", p.mode);
+            status = 400;
+            return false;
+          }
+          return true;
+        });
+        if (changed) sendState(request, 200, params.read());
+        else sendError(request, status, error);
+      });
+  server.on("/api/state", HTTP_OPTIONS, [](AsyncWebServerRequest *request) { // попередній запит браузера перед PATCH з іншого джерела
+    AsyncWebServerResponse *response = request->beginResponse(204);
     response->addHeader("Access-Control-Allow-Origin", "*");
+    response->addHeader("Access-Control-Allow-Methods", "GET, PATCH");
+    response->addHeader("Access-Control-Allow-Headers", "Content-Type");
     request->send(response);
   });
-  server.on("/mode7", HTTP_GET, [](AsyncWebServerRequest *request) {
-    mode = 7;
-    AsyncWebServerResponse *response = request->beginResponse(200, "text/plain", "OK");
+#if AUDIO_PROFILING
+  server.on("/profile", HTTP_GET, [](AsyncWebServerRequest *request) { // час етапів кадру; /profile?reset — почати заново
+    char report[1024];
+    Profiler::report(report, sizeof(report));
+    if (request->hasParam("reset")) Profiler::requestReset(); // обнулять задачі аналізу і світлодіодів — кожна свої етапи
+    AsyncWebServerResponse *response = request->beginResponse(200, "text/plain; charset=utf-8", report);
     response->addHeader("Access-Control-Allow-Origin", "*");
     request->send(response);
   });
+#endif
   /*
     Параметри:
       "/mode1" — це шлях (URL), на який сервер реагує. Якщо клієнт надсилає
@@ -192,9 +449,30 @@ void webServerTask(void *pvParameters) { // завдання для веб-се
       lambda(); // Виведе 5
   */
 
-  server.begin(); // запускаємо веб-сервер
-  Serial.println("HTTP-сервер запущено на ядрі 0!");
-  for (;;) vTaskDelay(10 / portTICK_PERIOD_MS);
+  // /ws: клієнт отримує двійкові кадри ознак (формат — у FeatureStream.h) і може надіслати текст
+  // "fps=N", щоб змінити їх частоту. Обробник працює в задачі AsyncTCP — лише кладе подію в чергу
+  ws.onEvent([](AsyncWebSocket *socket, AsyncWebSocketClient *client, AwsEventType type, void *arg, uint8_t *data, size_t len) {
+    if (type == WS_EVT_CONNECT) streamEvents.push(StreamEvent{StreamEvent::CONNECT, client->id(), STREAM_FPS});
+    else if (type == WS_EVT_DISCONNECT) streamEvents.push(StreamEvent{StreamEvent::DISCONNECT, client->id(), 0});
+    else if (type == WS_EVT_DATA) {
+      AwsFrameInfo *info = (AwsFrameInfo *)arg;
+      if (info->final && info->index == 0 && info->len == len && info->opcode == WS_TEXT && len > 4 && len < 8 &&
+          !memcmp(data, "fps=", 4)) {
+        char number[4] = {0};
+        memcpy(number, data + 4, len - 4);
+        streamEvents.push(StreamEvent{StreamEvent::RATE, client->id(), atoi(number)});
+      }
+    }
+  });
+  server.addHandler(&ws);
+
+  // Веб-сервер запускається, коли з’явиться Wi-Fi (maintainWifi), — до того задача лише стежить за
+  // підключенням; аналіз звуку і світлодіоди тим часом уже працюють
+  for (;;) {
+    maintainWifi(millis());
+    streamFeatures(millis()); // між запитами — розсилка кадрів ознак клієнтам /ws
+    vTaskDelay(10 / portTICK_PERIOD_MS);
+  }
   /*
     vTaskDelay - це функція FreeRTOS, яка призупиняє виконання поточного
     завдання на певний час, дозволяючи іншим завданням працювати. Параметр: 10 /
@@ -210,14 +488,20 @@ void webServerTask(void *pvParameters) { // завдання для веб-се
   */
 }
 
-void lightMusicTask(void *pvParameters) { // обробка звуку та керування світлодіодами, працює на ядрі 1.
+static void applyToPipeline(const LightParams &p) { // підсилення, пороги і згладжування (крок 9)
+  for (int b = 0; b < p.gainCount; b++) pipeline.bandMap().setGain(b, p.gains[b]);
+  pipeline.setThresholds(p.thresholds[0], p.thresholds[1], p.thresholds[2]);
+  pipeline.setSmoothing(p.smoothing);
+}
+
+void analysisTask(void *pvParameters) { // обробка звуку (кроки 1–9), працює на ядрі ANALYSIS_CORE
   /*
     Логіка роботи: аналіз звуку з аналогового входу, обробка сигналу за
     допомогою FFT для виділення частотних компонентів (баси, середні, високі).
     Керування світлодіодами WS2812B через бібліотеку FastLED у режимах, які
     перемикаються через веб-сервер. 
     Кроки перетворення "сирих" значень у плавну світломузику: 
-      1) Збір зразків: зчитування 128 значень з мікрофона (analogRead). 
+      1) Збір зразків: 128 значень з мікрофона, захоплених АЦП через I2S/DMA. 
       2) Корекція аномалій: заміна значень < 0 або > 4095 на попереднє або 2048. 
       3) Видалення DC: віднімання середнього для усунення постійної складової. 
       4) Фільтрація: застосування IIR-фільтра для згладжування. 
@@ -227,461 +511,266 @@ void lightMusicTask(void *pvParameters) { // обробка звуку та ке
       8) Нормалізація: масштабування амплітуд за енергією сигналу.
       9) Ковзне середнє: згладжування амплітуд із часом.
       10) Керування LED: переведення амплітуд у кольори/яскравість залежно від
-    режиму.
+    режиму — окрема задача renderTask, яка бере найсвіжіший кадр ознак із latestFrame.
   */
-  static double avgAmpR = 0, avgAmpG = 0, avgAmpB = 0; // середні амплітуди між ітераціями lightMusicTask
-  static unsigned long current_time;
-  /*
-    Звичайна локальна змінна "забувається" після завершення функції. Статична
-    зберігається в пам’яті і доступна при наступному виклику. Ініціалізація (=
-    0) відбувається лише при першому запуску функції. Переваги: 1) Збереження
-    стану: дозволяє накопичувати дані (наприклад, середні значення) без
-    використання глобальних змінних. 2) Обмежена видимість: доступні лише
-    всередині функції, що покращує інкапсуляцію. 3) Ефективність: не потребують
-    повторної ініціалізації.
-  */
-  static int count = 0;
-
-  current_time = millis();
-
-  while (true) {                        // безкінечний цикл обробки звуку та оновлення світлодіодів
-    for (int i = 0; i < SAMPLES; i++) { // 1) Збір зразків: зчитування 128 значень з мікрофона. +робимо
-                                        // перевірку на аномалії за межами діапазону АЦП ESP32 (0–4095)
-      vReal[i] = analogRead(34);        // зчитуємо зразки із аналогового входу
-      vRawData[i] = vReal[i];           // зберігаємо копію "сирих" даних для порівняння у світломузиці
-      vImag[i] = 0;                     // уявна частина сигналу не потрібна для реального входу
-      if (vReal[i] < 0 || vReal[i] > 4095)
-        vReal[i] = (i > 0) ? vReal[i - 1] : 2048; // 2) Корекція аномалій: заміна значень <0
-                                                  // або >4095 на попереднє або 2048
-      /*
-        Чому значення може бути поза межами 0 - 4095:
-          1) шум - мікрофон або АЦП можуть видавати аномальні значення через
-        електричні перешкоди. 2) помилки АЦП - апаратні збої можуть призводити
-        до некоректних даних. Теоретично analogRead не повинен повертати < 0 або
-        > 4095, але код додає захист від таких випадків.
-
-        Використовуємо тернарний оператор (?:) :
-          (i > 0) — умова: якщо це не перший зразок.
-          vReal[i-1] — якщо умова істинна, береться попереднє значення.
-          2048 — якщо умова хибна (перший зразок), використовується середнє
-        значення діапазону АЦП (4096/2).
-      */
-      delayMicroseconds(1000000 / SAMPLING_FREQ);
-    }
-
-    double mean = 0; // 3) Видалення DC: віднімання середнього для усунення постійної
-                     // складової. Починаємо з підрахунку середнього значення сигналу
-    for (int i = 0; i < SAMPLES; i++) mean += vReal[i];
-    mean /= SAMPLES;
-    // віднімаємо середнє значення сигналу (mean) від кожного зразка, щоб позбутися постійної складової (DC offset)
-    for (int i = 0; i < SAMPLES; i++) vReal[i] -= mean;
-
-    static unsigned long lastPrint = 0; // виводимо "сирі" дані з мікрофона (після видалення DC); static -
-                                        // щоб змінна зберігала значення між викликами функції
-    if (millis() - lastPrint >= 5000) {
-      Serial.println("Сигнал із мікрофона (сирі дані, після видалення DC):");
-      for (int i = 0; i < SAMPLES; i++) {
-        Serial.print(vReal[i]);
-        Serial.print(" ");
-        if ((i + 1) % 16 == 0) Serial.println(); // розділяємо на групи по 16 значень
-      }
-      Serial.println();
+  uint32_t sequence = 0;
+  LightParams settings = params.read();
+  applyToPipeline(settings);
+  while (true) { // безкінечний цикл: кадр ознак на кожен крок hop
+    // Параметри змінено через веб-сервер — знімаємо копію блоку без блокувань (seqlock) і застосовуємо
+    // один раз; до наступної зміни кадр бачить лише свою копію, а не поля, що змінюються посеред кадру
+    if (params.version() != settings.version && params.tryRead(settings)) applyToPipeline(settings);
+    // 1) Збір зразків: чекаємо hop нових зразків, які АЦП захопив через DMA. Захоплення йде
+    // безперервно і без участі ядра, а ковзне вікно аналізує кожен крок разом із (SAMPLES - hop)
+    // попередніми зразками — жоден шматок звуку не пропускається, а спектр оновлюється кожні
+    // hop / SAMPLING_FREQ секунд незалежно від того, як часто оновлюються світлодіоди
+    window.setHop(settings.hop);
+    {
+      PROFILE_SCOPE(PROFILE_READ);
+      source.read(block, window.hop(), portMAX_DELAY);
     }
+    window.push(block, window.hop());
+    if (!window.ready()) continue; // перше вікно ще не заповнене
+    window.frame(frame);
+    // Якщо кадри світлодіодів не встигають (ядро перевантажене), планувальник підвищує рівень
+    // деградації — і кожен рівень удвічі зменшує кількість кадрів аналізу на секунду звуку
+    if (!throttle.step(degradeLevel, window.hop())) continue;
+
+    int currentMode = settings.mode;
+    const ModeDescriptor *descriptor = findMode(currentMode);
+    pipeline.setFeatures(descriptor ? descriptor->features : FEATURE_ALL);
+    // "Сирі" дані з мікрофона (зразки АЦП кадру) — раз на 5 с; лише копія в чергу телеметрії
+    if (analysisTelemetry.due(TELEMETRY_SIGNAL, millis())) analysisTelemetry.log(TELEMETRY_SIGNAL, millis(), frame, SAMPLES);
+
+    // 2-4) Корекція аномалій, видалення DC, фільтрація (нові зразки — ще й у низькочастотну гілку)
+    pipeline.preprocess(frame, min(throttle.newSamples(), SAMPLES));
+    pipeline.computeSpectrum(); // 5-6) Спектр (FFT, Герцель або нічого — за режимом)
+    pipeline.computeBands();    // 7-8) Розподіл частот і нормалізація
+    pipeline.smooth();          // 9) Ковзне середнє і пороги
+
+    FeatureFrame out;
+    out.features = pipeline.features();
+    out.mode = currentMode;
+    out.sequence = sequence++;
+    unsigned features = descriptor ? descriptor->features : FEATURE_ALL;
+    bool raw = features & FEATURE_RAW;
+    out.rawAmplitude = raw ? pipeline.rawAmplitude() : 0; // спрощена обробка "сирих" даних (mode 4)
+    out.raw = raw && (features & FEATURE_BANDS) ? pipeline.computeRawBands() : BandAmps{0, 0, 0}; // той самий аналіз без IIR (mode 5)
+    latestFrame.publish(out); // замінює ще не показаний кадр; аналіз ніколи не чекає світлодіодів
+  }
+}
 
-    // 4) Фільтрація: застосування IIR-фільтра для згладжування - простий рекурсивний фільтр сигналу (IIR) щоб згладити сигнал
-    double filtered[SAMPLES];
+static void renderFrame(const FeatureFrame &latest) { // 10) один кадр світлодіодів із найсвіжіших ознак
+  const AudioFeatures &f = latest.features;
 
-    for (int i = 0; i < SAMPLES; i++) {
-      filtered[i] = vReal[i];
-      if (i > 0) filtered[i] = 0.7 * filtered[i - 1] + 0.3 * vReal[i]; // IIR-фільтр: 70% попереднього значення + 30% поточного
-    }
-    for (int i = 0; i < SAMPLES; i++) vReal[i] = filtered[i];
-    /*
-      IIR — Infinite Impulse Response (нескінченна імпульсна характеристика) —
-      тип цифрового фільтра, який використовує попередні вихідні значення для
-      обчислення нового. Це рекурсивний фільтр: 70% попереднього значення + 30%
-      поточного. Він згладжує сигнал, зменшуючи різкі стрибки. На відміну від
-      FIR (Finite Impulse Response), який працює лише з вхідними даними, IIR
-      "пам’ятає" попередні результати, що робить його ефективнішим для
-      згладжування. Коефіцієнти (0.7 і 0.3) визначають "силу" згладжування (сума
-      = 1 для стабільності). Переваги: простота реалізації і низьке споживання
-      ресурсів.
-    */
+  // для відлагодження — амплітуди, середня енергія і лічильники (друкує telemetryTask)
+  uint32_t now = millis();
+  if (renderTelemetry.due(TELEMETRY_BANDS, now)) {
+    float values[4 + MAX_BANDS] = {(float)f.ampR, (float)f.ampG, (float)f.ampB, (float)f.avgEnergy};
+    for (int b = 0; b < f.bandCount; b++) values[4 + b] = f.bands[b];
+    renderTelemetry.log(TELEMETRY_BANDS, now, values, 4 + f.bandCount);
+  }
+  if (renderTelemetry.due(TELEMETRY_STATS, now)) {
+    float values[] = {(float)latestFrame.lost(), (float)strips.shown(),    (float)strips.skipped(),
+                      (float)scheduler.overruns(),  (float)scheduler.level(), (float)uxTaskGetStackHighWaterMark(analysisHandle),
+                      (float)uxTaskGetStackHighWaterMark(renderHandle)};
+    renderTelemetry.log(TELEMETRY_STATS, now, values, 7);
+  }
 
-    // 5) FFT: перетворення в частотну область (windowing, compute) - виконуємо
-    // послідовно три процедури Fast Fourier Transform, FFT:
-    FFT.windowing(vReal, SAMPLES, FFT_WIN_TYP_HAMMING, FFT_FORWARD); // Функція для зменшення впливу країв сигналу
-    /*
-      Коли ми беремо скінченний набір зразків сигналу (наприклад, 128 зразків із
-      частотою 10 кГц, як у нас), ми фактично "вирізаємо" шматок із
-      безперервного сигналу. Цей процес обрізання називається truncation, і він
-      створює проблему: краї обрізаного сигналу (початок і кінець) стають
-      різкими перепадами (discontinuities), навіть якщо оригінальний сигнал був
-      плавним (наприклад, синусоїда). Ці різкі перепади призводять до появи
-      спектральних витоків (spectral leakage) у частотній області після FFT.
-      Спектральні витоки — це коли енергія однієї частоти "розмазується" на
-      сусідні частоти, спотворюючи результат аналізу спектра. Віконне зважування
-      вирішує цю проблему, згладжуючи краї сигналу перед FFT: 1) множить кожен
-      зразок сигналу на певну вагу, яка залежить від його позиції у наборі
-      даних. 2) зазвичай ваги на краях (біля 0 і 127, як у нас) близькі до 0, а
-      в центрі (біля 64) — максимальні.
-
-      Використовуємо одну з популярних віконних функцій - вікно Хеммінга
-      (FFT_WIN_TYP_HAMMING). До віконування масив vReal містить "сирі" зразки з
-      мікрофона, наприклад: [100, 102, 105, ..., 98]. Після віконування кожен
-      елемент vReal[i] множиться на відповідне значення вікна Хеммінга: vReal[0]
-      = vReal[0] * 0.08 (зменшується). vReal[63] = vReal[63] * 1.0 (залишається
-      майже без змін). vReal[127] = vReal[127] * 0.08 (зменшується). Результат:
-        Сигнал стає плавнішим на краях, що зменшує різкі перепади.
-        Зменшується вплив країв сигналу - без віконування обрізаний сигнал
-      виглядає як прямокутник (усі зразки мають однакову вагу), що додає
-      високочастотні артефакти в спектр.
-
-      Вікно Хеммінга "згладжує" краї, роблячи сигнал схожим на дзвін, що знижує
-      ці артефакти. Хоча вікно трохи розширює основну частотну складову (main
-      lobe), воно значно зменшує бічні піки (side lobes), що робить спектр
-      чіткішим. Додається точність аналізу - це важливо для коректного розподілу
-      частот на світлодіоди (низькі, середні, високі), щоб шум від різких країв
-      не спотворював результат.
-
-      Бібліотека arduinoFFT підтримує й інші вікна:
-        1) FFT_WIN_TYP_RECTANGLE (без зважування, прямокутне вікно — найгірше
-      для витоків). 2) FFT_WIN_TYP_HANN (вікно Ханна — схоже на Хеммінга, але з
-      іншими характеристиками). 3) FFT_WIN_TYP_BLACKMAN (ще сильніше придушення
-      бічних піків). Хеммінг — хороший компроміс між роздільністю і придушенням
-      витоків.
-    */
+  output.clear(); // 10) Керування LED: переведення амплітуд у кольори/яскравість залежно від режиму
+  const ModeDescriptor *descriptor = findMode(latest.mode); // режим, для якого рахувались ознаки (а не щойно вибраний)
+  {
+    PROFILE_SCOPE(PROFILE_RENDER);
+    if (descriptor) descriptor->render(latest); // номер режиму — індекс у реєстрі, без ланцюжка if
+  }
+  // Передаємо лише стрічки, що змінились (хеш їхніх пікселів інший, ніж під час попереднього
+  // виводу); RmtLedOutput передає їх одночасно, FastLedOutput — усі разом, якщо змінилась хоч одна
+  uint32_t dirty = strips.changed();
+  if (dirty) {
+    PROFILE_SCOPE(PROFILE_SHOW);
+    output.show(dirty);
+  }
+  if (dirty && firstFrameUs == 0) { // час від старту до першого кадру (друкує telemetryTask)
+    firstFrameUs = micros();
+    float ms = firstFrameUs / 1000.0f;
+    renderTelemetry.log(TELEMETRY_BOOT, millis(), &ms, 1);
+  }
+  if (streamClientCount > 0) streamQueue.push(latest); // для /ws; черга повна — веб-сервер ще не забрав попередні
+}
 
-    FFT.compute(vReal, vImag, SAMPLES, FFT_FORWARD); // перетворення сигналу в частотну область
-    /*
-      Виконує швидке перетворення Фур’є (FFT), перетворюючи сигнал із часової
-      області (зразки з мікрофона) у частотну область (амплітуди частот). Бере
-      масиви vReal (реальна частина) і vImag (уявна частина) і обчислює спектр
-      частот. vReal — масив реальних значень сигналу (вхід і вихід). vImag —
-      масив уявних значень (початково 0, змінюється під час обчислень). SAMPLES
-      — розмір масиву, має бути степенем 2. FFT_FORWARD — напрямок перетворення
-      (пряме FFT). Інший варіант: FFT_REVERSE (зворотне FFT). Після виконання
-      vReal і vImag містять комплексні числа, що представляють частотний спектр.
-    */
+void renderTask(void *pvParameters) { // 10) керування світлодіодами, працює на ядрі RENDER_CORE
+  FeatureFrame latest;
+  bool haveFrame = false;
+  LightParams settings = params.read();
 
-    FFT.complexToMagnitude(vReal, vImag, SAMPLES); // 6) Обчислення амплітуд: перехід до величин
-                                                   // (complexToMagnitude) перетворює комплексні числа у
-                                                   // величину (амплітуду) для кожної частоти
-
-    ampR = 0;
-    ampG = 0;
-    ampB = 0; // 7) Розподіл частот: поділ на баси, середні, високі: R - баси
-              // (0–20), G - середні (20–80), B - високі (80–128)
-    for (int i = 0; i < SAMPLES; i++) {
-      if (i < 20) ampR += abs(vReal[i]);
-      else if (i < 80)
-        ampG += abs(vReal[i]);
-      else
-        ampB += abs(vReal[i]);
-    }
-    ampR /= 20; // усереднюємо амплітуди басів
-    ampG /= 60; // усереднюємо амплітуди середніх частот
-    ampB /= 48; // усереднюємо амплітуди високих частот
-
-    double totalEnergy = 0; // 8) Нормалізація: масштабування амплітуд за енергією сигналу.
-    for (int i = 0; i < SAMPLES; i++) {
-      totalEnergy += vReal[i] * vReal[i]; // енергія = сума квадратів амплітуд
-      /*
-        енергія = сума квадратів амплітуд бо енергія сигналу як фізична величина
-        - пропорційна квадрату амплітуди. Корінь із середньої суми квадратів
-        (sqrt(totalEnergy / SAMPLES)) дає середню амплітуду.
-      */
-    }
-    double avgEnergy = sqrt(totalEnergy / SAMPLES); // нормалізуємо амплітуди за енергією
-                                                    // сигналу (відносно середньої енергії)
-    /*
-      нормалізація - приведення даних до певного масштабу (наприклад, відносно
-      середнього значення або енергії). Зменшує вплив фонового шуму, але
-      конкретні коефіцієнти залежать від конкретного мікрофона і середовища
-      роботи.
-    */
-    if (avgEnergy > 0) {
-      ampR = (ampR / avgEnergy) * 150; // підсилення басів
-      ampG = (ampG / avgEnergy) * 100; // підсилення середніх частот
-      ampB = (ampB / avgEnergy) * 150; // підсилення високих частот
+  while (true) { // безкінечний цикл оновлення світлодіодів: кадр на кожен дедлайн планувальника
+    if (params.version() != settings.version && params.tryRead(settings)) {
+      if (output.brightness() != settings.brightness) {
+        output.setBrightness(settings.brightness);
+        strips.invalidate(); // пікселі ті самі, але на стрічках має змінитись яскравість
+      }
     }
+    if (scheduler.fps() != settings.fps) scheduler.setFps(settings.fps);
+    scheduler.frameStart(micros());
+    // Показуємо найсвіжіший кадр задачі аналізу (якщо з’явився новий — копіюємо його без блокувань)
+    if (latestFrame.take(latest, FEATURE_READ_ATTEMPTS)) haveFrame = true; // не вдалось — показуємо попередній
+    if (haveFrame) renderFrame(latest);
+
+    // Спимо до дедлайну наступного кадру (відлік — від початку роботи, як у vTaskDelayUntil), тож
+    // частота кадрів не залежить від того, скільки тривав кадр. Сон округлюємо вгору до тіка FreeRTOS
+    uint32_t sleepUs = scheduler.frameEnd(micros());
+    degradeLevel = scheduler.level(); // задача аналізу перейде на дешевший крок, якщо кадри не встигають
+    vTaskDelay((sleepUs + 999) / 1000 / portTICK_PERIOD_MS);
     /*
-      Підсилюємо амплітуди - вирішуємо проблему різної гучності: тихий сигнал не
-      "гасить" світлодіоди, а гучний не перевантажує їх Після нормалізації
-      амплітуди можуть бути замалими для світлодіодів (0–255). Множники (150,
-      100, 150) масштабують їх до видимого діапазону.
+      Ядро 0 (10 мс): веб-сервер потребує швидкої реакції на запити, тому
+      затримка менша. 
+      Світлодіоди (RENDER_FPS = 20 кадрів/с, 50 мс на кадр): менш критичні до часу,
+      а більша затримка економить ресурси; звук тим часом аналізується у своєму темпі.
+      Частоту можна змінити через /fps?n=... (20 Гц достатньо для плавності світломузики).
     */
+  }
+}
 
-    // 9) Ковзне середнє: згладжування значень амплітуд із часом - усереднюємо амплітуди для плавної зміни кольорів
-    avgAmpR = (avgAmpR * count + ampR) / (count + 1);
-    avgAmpG = (avgAmpG * count + ampG) / (count + 1);
-    avgAmpB = (avgAmpB * count + ampB) / (count + 1);
-    count++;
-    if (count > 50) count = 50;
-
-    //  пороги потрібні для реалізації конкретної ідеї світломузики на led-кружальці - для визначення кількості led які мають світитись
-    int porigR = avgAmpR * 0.8;
-    int porigG = avgAmpG * 1.2;
-    int porigB = avgAmpB * 0.8;
-
-    // для відлагодження виводимо інформацію про амплітуди та середню енергію
-    if (millis() - lastPrint >= 5000) {
+static void printRecord(const TelemetryRecord &r) { // розбирає двійковий запис у текст
+  const float *v = r.values;
+  if (r.part == 0) {
+    Serial.print("[");
+    Serial.print(r.timeMs);
+    Serial.print(" мс] ");
+  }
+  switch (r.category) {
+  case TELEMETRY_SIGNAL: // зразки по 16 у рядку (дві частини записів)
+    if (r.part == 0) Serial.println("Сигнал із мікрофона (сирі дані АЦП):");
+    for (int i = 0; i < r.count; i++) {
+      Serial.print(v[i]);
+      Serial.print(" ");
+    }
+    if (r.part % 2 == 1 || r.part + 1 == r.parts) Serial.println();
+    break;
+  case TELEMETRY_BANDS: // ampR, ampG, ampB, avgEnergy, потім діапазони (можуть продовжуватись у наступних частинах)
+    if (r.part == 0) {
       Serial.print("Амплітуди: R = ");
-      Serial.print(ampR);
+      Serial.print(v[0]);
       Serial.print(", G = ");
-      Serial.print(ampG);
+      Serial.print(v[1]);
       Serial.print(", B = ");
-      Serial.println(ampB);
+      Serial.println(v[2]);
       Serial.print("Середня енергія: ");
-      Serial.println(avgEnergy);
-      lastPrint = millis();
+      Serial.println(v[3]);
+      Serial.print("Діапазони:");
     }
-
-    // clang-format off
-    FastLED.clear(); // 10) Керування LED: переведення амплітуд у кольори/яскравість залежно від режиму
-    if (mode == 1) { // велике коло (16 LED)
-      if (ampR < porigR) leds_16_circle[0] = CRGB(255, 0, 0); 
-      else if (ampR < porigR * 1.25) std::fill(leds_16_circle + 0, leds_16_circle + 2, CRGB(255, 0, 0));
-      else if (ampR < porigR * 1.5) std::fill(leds_16_circle + 0, leds_16_circle + 3, CRGB(255, 0, 0));
-      else if (ampR < porigR * 1.75) std::fill(leds_16_circle + 0, leds_16_circle + 4, CRGB(255, 0, 0));
-      else if (ampR < porigR * 2) std::fill(leds_16_circle + 0, leds_16_circle + 5, CRGB(255, 0, 0));
-      else std::fill(leds_16_circle + 0, leds_16_circle + 6, CRGB(255, 0, 0));
-
-      if (ampG < porigG) leds_16_circle[6] = CRGB(0, 255, 0);
-      else if (ampG < porigG * 1.3) std::fill(leds_16_circle + 6, leds_16_circle + 8, CRGB(0, 255, 0));
-      else if (ampG < porigG * 1.6) std::fill(leds_16_circle + 6, leds_16_circle + 9, CRGB(0, 255, 0));
-      else if (ampG < porigG * 1.9) std::fill(leds_16_circle + 6, leds_16_circle + 10, CRGB(0, 255, 0));
-      else std::fill(leds_16_circle + 6, leds_16_circle + 11, CRGB(0, 255, 0));
-
-      if (ampB < porigB) leds_16_circle[11] = CRGB(0, 0, 255);
-      else if (ampB < porigB * 1.3) std::fill(leds_16_circle + 11, leds_16_circle + 13, CRGB(0, 0, 255));
-      else if (ampB < porigB * 1.6) std::fill(leds_16_circle + 11, leds_16_circle + 14, CRGB(0, 0, 255));
-      else if (ampB < porigB * 1.9) std::fill(leds_16_circle + 11, leds_16_circle + 15, CRGB(0, 0, 255));
-      else std::fill(leds_16_circle + 11, leds_16_circle + NUM_LEDS_16_CIRCLE, CRGB(0, 0, 255));
-
-    } else if (mode == 2) { // мале коло (12 LED)
-      if (small_circle < NUM_LEDS_12_CIRCLE);
-      else small_circle = 0;
-      leds_12_circle[small_circle] = CRGB(0, 0, 255);
-      if (millis() - current_time > 1000000 / avgEnergy) {
-        Serial.print(millis() - current_time);
-        Serial.print(" > ");
-        Serial.print(1000000 / avgEnergy);
-        Serial.println("");
-
-        small_circle++;
-        current_time = millis();
-      }
-
-    } else if (mode == 3) { // велике коло (16)
-
-           if (avgEnergy <= 250) std::fill(leds_16_circle + 0 , leds_16_circle + 1, CRGB(255, 0, 170));
-      else if (avgEnergy <= 500) std::fill(leds_16_circle + 0 , leds_16_circle + 2, CRGB(255, 0, 170));
-      else if (avgEnergy <= 750) std::fill(leds_16_circle + 0 , leds_16_circle + 3, CRGB(255, 0, 170));
-      else if (avgEnergy <= 1000) std::fill(leds_16_circle + 0 , leds_16_circle + 4, CRGB(255, 0, 170));
-      else if (avgEnergy <= 1250) std::fill(leds_16_circle + 0 , leds_16_circle + 5, CRGB(255, 0, 170));
-      else if (avgEnergy <= 1500) std::fill(leds_16_circle + 0 , leds_16_circle + 6, CRGB(255, 0, 170));
-      else if (avgEnergy <= 1750) std::fill(leds_16_circle + 0 , leds_16_circle + 7, CRGB(255, 0, 170));
-      else if (avgEnergy <= 2000) std::fill(leds_16_circle + 0 , leds_16_circle + 8, CRGB(255, 0, 170));
-      else if (avgEnergy <= 2250) std::fill(leds_16_circle + 0 , leds_16_circle + 9, CRGB(255, 0, 170));
-      else if (avgEnergy <= 2500) std::fill(leds_16_circle + 0 , leds_16_circle + 10, CRGB(255, 0, 170));
-      else if (avgEnergy <= 2750) std::fill(leds_16_circle + 0 , leds_16_circle + 11, CRGB(255, 0, 170));
-      else if (avgEnergy <= 3000) std::fill(leds_16_circle + 0 , leds_16_circle + 12, CRGB(255, 0, 170));
-      else if (avgEnergy <= 3250) std::fill(leds_16_circle + 0 , leds_16_circle + 13, CRGB(255, 0, 170));
-      else if (avgEnergy <= 3500) std::fill(leds_16_circle + 0 , leds_16_circle + 14, CRGB(255, 0, 170));
-      else if (avgEnergy <= 3750) std::fill(leds_16_circle + 0 , leds_16_circle + 15, CRGB(255, 0, 170));
-      else if (avgEnergy <= 4000) std::fill(leds_16_circle + 0 , leds_16_circle + 16, CRGB(255, 0, 170));
-      
- //     Serial.print(avgEnergy);
-    } else if (mode == 4) { // лівий квадрат (vRawData, транспонований, без FFT, 3 стовпчики)
-      // 1. Спрощена обробка "сирих" даних із vRawData
-      double rawMean = 0;
-      for (int i = 0; i < SAMPLES; i++) rawMean += vRawData[i];
-      rawMean /= SAMPLES; // Середнє значення сирих даних
-  
-      double rawAmplitude = 0;
-      for (int i = 0; i < SAMPLES; i++) {
-          rawAmplitude += abs(vRawData[i] - rawMean); // Абсолютна різниця від середнього
-      }
-      rawAmplitude /= SAMPLES; // Середня амплітуда відхилення
-  
-      // Масштабуємо амплітуду до 0–12 світлодіодів
-      int numLeds = map(rawAmplitude, 0, 500, 0, 13); // 0–12 LED, 500 — поріг чутливості
-      numLeds = constrain(numLeds, 0, 12);
-  
-      // 2. Очищаємо світлодіоди перед новим заповненням
-      FastLED.clear();
-  
-      // 3. Лівий квадрат: заповнення вертикальних стовпчиків
-      // Масиви індексів для кожного стовпчика
-      int redColumn[] = {0, 7, 8, 15};   // Перший стовпчик (червоний)
-      int greenColumn[] = {1, 6, 9, 14}; // Другий стовпчик (зелений)
-      int blueColumn[] = {2, 5, 10, 13}; // Третій стовпчик (синій)
-  
-      // Перший стовпчик (червоний): 0, 7, 8, 15 (до 4 LED)
-      if (numLeds > 0) {
-          for (int i = 0; i < min(numLeds, 4); i++) {
-              leds_L_SQUARE[redColumn[i]] = CRGB(255, 0, 0);
-          }
-      }
-      // Другий стовпчик (зелений): 1, 6, 9, 14 (наступні 4 LED, 5–8)
-      if (numLeds > 4) {
-          for (int i = 0; i < min(numLeds - 4, 4); i++) {
-              leds_L_SQUARE[greenColumn[i]] = CRGB(0, 255, 0);
-          }
-      }
-      // Третій стовпчик (синій): 2, 5, 10, 13 (наступні 4 LED, 9–12)
-      if (numLeds > 8) {
-          for (int i = 0; i < min(numLeds - 8, 4); i++) {
-              leds_L_SQUARE[blueColumn[i]] = CRGB(0, 0, 255);
-          }
-      }
-  
-      // 4. Показуємо результат
-      FastLED.show();
-  
-    } else if (mode == 5) { // лівий квадрат (vRawData), правий квадрат (vReal, інвертований)
-      // 1. Обробка "сирих" даних із vRawData для лівого квадрата
-      double rawReal[SAMPLES]; // Тимчасовий масив для реальних частин
-      double rawImag[SAMPLES]; // Тимчасовий масив для уявних частин
-      
-      // Копіюємо сирі дані та готуємо їх для FFT
-      for (int i = 0; i < SAMPLES; i++) {
-          rawReal[i] = vRawData[i];
-          rawImag[i] = 0; // Уявна частина = 0
-      }
-  
-      // Видаляємо DC offset (постійну складову)
-      double rawMean = 0;
-      for (int i = 0; i < SAMPLES; i++) rawMean += rawReal[i];
-      rawMean /= SAMPLES;
-      for (int i = 0; i < SAMPLES; i++) rawReal[i] -= rawMean;
-  
-      // Виконуємо FFT для сирих даних
-      FFT.windowing(rawReal, SAMPLES, FFT_WIN_TYP_HAMMING, FFT_FORWARD);
-      FFT.compute(rawReal, rawImag, SAMPLES, FFT_FORWARD);
-      FFT.complexToMagnitude(rawReal, rawImag, SAMPLES);
-  
-      // Розподіл частот для сирих даних
-      double rawAmpR = 0, rawAmpG = 0, rawAmpB = 0;
-      for (int i = 0; i < SAMPLES; i++) {
-          if (i < 20) rawAmpR += abs(rawReal[i]);
-          else if (i < 80) rawAmpG += abs(rawReal[i]);
-          else rawAmpB += abs(rawReal[i]);
-      }
-      rawAmpR /= 20; // Усереднення басів
-      rawAmpG /= 60; // Усереднення середніх
-      rawAmpB /= 48; // Усереднення високих
-  
-      // Нормалізація за енергією
-      double rawTotalEnergy = 0;
-      for (int i = 0; i < SAMPLES; i++) {
-          rawTotalEnergy += rawReal[i] * rawReal[i];
-      }
-      double rawAvgEnergy = sqrt(rawTotalEnergy / SAMPLES);
-      if (rawAvgEnergy > 0) {
-          rawAmpR = (rawAmpR / rawAvgEnergy) * 150;
-          rawAmpG = (rawAmpG / rawAvgEnergy) * 100;
-          rawAmpB = (rawAmpB / rawAvgEnergy) * 150;
-      }
-  
-      // 2. Масштабування амплітуд до кількості світлодіодів (0–4)
-      int numLedsR_raw = map(rawAmpR, 0, 255, 0, 5); // Баси для vRawData
-      int numLedsG_raw = map(rawAmpG, 0, 255, 0, 5); // Середні для vRawData
-      int numLedsB_raw = map(rawAmpB, 0, 255, 0, 5); // Високі для vRawData
-  
-      int numLedsR = map(ampR, 0, 255, 0, 5); // Баси для vReal
-      int numLedsG = map(ampG, 0, 255, 0, 5); // Середні для vReal
-      int numLedsB = map(ampB, 0, 255, 0, 5); // Високі для vReal
-  
-      // Обмежуємо до 4 світлодіодів
-      numLedsR_raw = constrain(numLedsR_raw, 0, 4);
-      numLedsG_raw = constrain(numLedsG_raw, 0, 4);
-      numLedsB_raw = constrain(numLedsB_raw, 0, 4);
-      numLedsR = constrain(numLedsR, 0, 4);
-      numLedsG = constrain(numLedsG, 0, 4);
-      numLedsB = constrain(numLedsB, 0, 4);
-  
-      // 3. Очищаємо світлодіоди перед новим заповненням
-      FastLED.clear();
-  
-      // 4. Лівий квадрат (vRawData): заповнення стовпчиків (без змін)
-      // Червоний (баси): 0–3
-      fill_solid(leds_L_SQUARE, numLedsR_raw, CRGB(255, 0, 0));
-      // Зелений (середні): 4–7
-      fill_solid(leds_L_SQUARE + 4, numLedsG_raw, CRGB(0, 255, 0));
-      // Синій (високі): 8–11
-      fill_solid(leds_L_SQUARE + 8, numLedsB_raw, CRGB(0, 0, 255));
-  
-      // 5. Правий квадрат (vReal): інвертоване заповнення стовпчиків
-      // Червоний (баси): 15–12
-      fill_solid(leds_R_SQUARE + (NUM_LEDS_R_SQUARE - numLedsR), numLedsR, CRGB(255, 0, 0));
-      // Зелений (середні): 11–8
-      fill_solid(leds_R_SQUARE + (NUM_LEDS_R_SQUARE - 4 - numLedsG), numLedsG, CRGB(0, 255, 0));
-      // Синій (високі): 7–4
-      fill_solid(leds_R_SQUARE + (NUM_LEDS_R_SQUARE - 8 - numLedsB), numLedsB, CRGB(0, 0, 255));
-  
-      // 6. Показуємо результат
-      FastLED.show();
-  
-  
-
-    } else if (mode == 6) { // обидва квадрати (32 LED)
-      int totalAmp = (ampR + ampG + ampB) / 3;
-      int brightness = map(totalAmp, 0, 600, 0, 255);
-      std::fill(leds_L_SQUARE + 0, leds_L_SQUARE + NUM_LEDS_L_SQUARE, CRGB(brightness, 0, 0));
-      std::fill(leds_R_SQUARE + 0, leds_R_SQUARE + NUM_LEDS_R_SQUARE, CRGB(0, brightness, 0));
-
-    } else if (mode == 7) { // усе разом (28 + 32 LED)
-      int totalAmp = (ampR + ampG + ampB) / 3;
-      int brightness = map(totalAmp, 0, 600, 0, 255);
-      std::fill(leds_16_circle + 0, leds_16_circle + NUM_LEDS_16_CIRCLE, CRGB(brightness, 0, 0));
-      std::fill(leds_12_circle + 0, leds_12_circle + NUM_LEDS_12_CIRCLE, CRGB(0, brightness, 0));
-      std::fill(leds_L_SQUARE + 0, leds_L_SQUARE + NUM_LEDS_L_SQUARE, CRGB(brightness, 0, 0));
-      std::fill(leds_R_SQUARE + 0, leds_R_SQUARE + NUM_LEDS_R_SQUARE, CRGB(0, brightness, 0));
+    for (int i = r.part == 0 ? 4 : 0; i < r.count; i++) {
+      Serial.print(" ");
+      Serial.print((int)v[i]);
     }
+    if (r.part + 1 == r.parts) Serial.println();
+    break;
+  case TELEMETRY_STATS: // втрачені кадри аналізу, кадри LED виведено/без змін, перевищення, рівень деградації, запас стеків
+    Serial.print("Втрачено кадрів аналізу: ");
+    Serial.println((unsigned long)v[0]);
+    Serial.print("Кадрів LED виведено / без змін: ");
+    Serial.print((unsigned long)v[1]);
+    Serial.print(" / ");
+    Serial.println((unsigned long)v[2]);
+    Serial.print("Кадрів LED не встигли / рівень деградації: ");
+    Serial.print((unsigned long)v[3]);
+    Serial.print(" / ");
+    Serial.println((int)v[4]);
+    Serial.print("Найменший вільний стек, байтів (аналіз / світлодіоди): ");
+    Serial.print((unsigned long)v[5]);
+    Serial.print(" / ");
+    Serial.println((unsigned long)v[6]);
+    Serial.print("Відкинуто повідомлень телеметрії (аналіз / світлодіоди): ");
+    Serial.print(analysisTelemetry.dropped());
+    Serial.print(" / ");
+    Serial.println(renderTelemetry.dropped());
+    break;
+  case TELEMETRY_SPINNER: // mode 2: час від попереднього кроку кола > поріг
+    Serial.print(v[0]);
+    Serial.print(" > ");
+    Serial.println(v[1]);
+    break;
+  case TELEMETRY_BOOT:
+    Serial.print("Перший кадр світлодіодів через ");
+    Serial.print(v[0]);
+    Serial.println(" мс від старту");
+    break;
+  }
+}
 
-    FastLED.show();
-    // clang-format on
+static void drainTelemetry(TelemetryChannel &channel) { // друкує все з черги, повідомлення — цілими
+  TelemetryRecord record;
+  bool open = false; // надруковано не всі частини повідомлення
+  while (true) {
+    if (!channel.pop(record)) {
+      if (!open) return;
+      vTaskDelay(1); // решта частин уже записується — чекаємо, щоб не перемішати з іншою чергою
+      continue;
+    }
+    printRecord(record);
+    open = record.part + 1 < record.parts;
+  }
+}
 
-    vTaskDelay(50 / portTICK_PERIOD_MS);
-    /*
-      Ядро 0 (10 мс): веб-сервер потребує швидкої реакції на запити, тому
-      затримка менша. 
-      Ядро 1 (50 мс): обробка звуку і світла менш критична до
-      часу, а більша затримка економить ресурси. Вибір числа залежить від
-      частоти оновлення (50 мс = 20 Гц, достатньо для плавності світломузики).
-    */
+void telemetryTask(void *pvParameters) { // вивід телеметрії в Serial, низький пріоритет на ядрі TELEMETRY_CORE
+  while (true) {
+    drainTelemetry(analysisTelemetry);
+    drainTelemetry(renderTelemetry);
+#if AUDIO_PROFILING
+    static unsigned long lastReport = 0;
+    if (millis() - lastReport >= 5000) { // гістограми читаються без зупинки задач і без блокувань: знімок може бути неузгодженим на один кадр
+      static char report[1024];
+      Profiler::report(report, sizeof(report));
+      Serial.print(report);
+      lastReport = millis();
+    }
+#endif
+    vTaskDelay(20 / portTICK_PERIOD_MS); // Serial блокує лише цю задачу — черги розраховані на ~1 с записів
   }
 }
 
 void setup() {
-  Serial.begin(115200);
-  delay(1000); // Даємо час для стабілізації UART
-
-  pinMode(34, INPUT);
-  FastLED.addLeds<WS2812B, LED_PIN_16_CIRCLE, GRB>(leds_16_circle, NUM_LEDS_16_CIRCLE);
-  FastLED.addLeds<WS2812B, LED_PIN_12_CIRCLE, GRB>(leds_12_circle, NUM_LEDS_12_CIRCLE);
-  FastLED.addLeds<WS2812B, LED_PIN_L_SQUARE, GRB>(leds_L_SQUARE, NUM_LEDS_L_SQUARE);
-  FastLED.addLeds<WS2812B, LED_PIN_R_SQUARE, GRB>(leds_R_SQUARE, NUM_LEDS_R_SQUARE);
-  FastLED.setBrightness(100);
-
+  Serial.begin(115200); // без паузи на "стабілізацію UART": кожна мілісекунда тут — затримка першого кадру
+
+  if (!source.begin()) Serial.println("Помилка запуску АЦП через I2S!"); // запускаємо безперервне захоплення звуку
+  Serial.print("Буфери DSP (DspArena): ");
+  Serial.print((unsigned)sizeof(DspArena));
+  Serial.print(" байтів, увесь конвеєр: ");
+  Serial.print((unsigned)sizeof(AudioPipeline));
+  Serial.println(" байтів статичної пам’яті");
+  // Номери стрічок (0–3) — біти маски StripTracker, тож порядок однаковий
+  output.addStrip(LED_PIN_16_CIRCLE, (uint8_t *)leds_16_circle, NUM_LEDS_16_CIRCLE);
+  output.addStrip(LED_PIN_12_CIRCLE, (uint8_t *)leds_12_circle, NUM_LEDS_12_CIRCLE);
+  output.addStrip(LED_PIN_L_SQUARE, (uint8_t *)leds_L_SQUARE, NUM_LEDS_L_SQUARE);
+  output.addStrip(LED_PIN_R_SQUARE, (uint8_t *)leds_R_SQUARE, NUM_LEDS_R_SQUARE);
+  output.setBrightness(params.read().brightness);
+  // setup() виконується на ядрі 1 — туди ж потрапляє переривання RMT, подалі від Wi-Fi на ядрі 0
+  if (!output.begin()) Serial.println("Помилка запуску виводу на світлодіоди!");
+  strips.attach(0, leds_16_circle, sizeof(leds_16_circle));
+  strips.attach(1, leds_12_circle, sizeof(leds_12_circle));
+  strips.attach(2, leds_L_SQUARE, sizeof(leds_L_SQUARE));
+  strips.attach(3, leds_R_SQUARE, sizeof(leds_R_SQUARE));
+
+  // Спершу — звук і світло: вони не залежать від мережі і стартують за мілісекунди
+  xTaskCreatePinnedToCore(analysisTask, "AnalysisTask", ANALYSIS_STACK, NULL, 5, &analysisHandle, ANALYSIS_CORE);
+  xTaskCreatePinnedToCore(renderTask, "RenderTask", 8192, NULL, 4, &renderHandle, RENDER_CORE);
+  xTaskCreatePinnedToCore(telemetryTask, "TelemetryTask", 4096, NULL, 1, NULL, TELEMETRY_CORE);
+
+  // Wi-Fi — без очікування: WiFi.begin лише запускає підключення, а про результат повідомляють події.
+  // Автоматичне перепідключення вимкнене — повторні спроби робить webServerTask з Backoff
+  WiFi.mode(WIFI_STA);
+  WiFi.setAutoReconnect(false);
+  WiFi.onEvent([](arduino_event_id_t event, arduino_event_info_t info) {
+    if (event == ARDUINO_EVENT_WIFI_STA_GOT_IP) wifiUp = true;
+    else if (event == ARDUINO_EVENT_WIFI_STA_DISCONNECTED) wifiUp = false;
+  });
+  wifiBackoff.start(millis());
   WiFi.begin(ssid, password);
-  while (WiFi.status() != WL_CONNECTED) {
-    delay(500);
-    Serial.print(".");
-  }
-  Serial.println("");
-  Serial.println("Wi-Fi підключено!");
-  Serial.print("IP-адреса: ");
-  Serial.println(WiFi.localIP());
-
   xTaskCreatePinnedToCore(webServerTask, "WebServerTask", 8192, NULL, 1, NULL, 0);
-  xTaskCreatePinnedToCore(lightMusicTask, "LightMusicTask", 16384, NULL, 5, NULL, 1);
   /*
     Параметри:
-      lightMusicTask — функція-завдання.
-      "LightMusicTask" — ім’я для дебагу.
+      analysisTask — функція-завдання.
+      "AnalysisTask" — ім’я для дебагу.
       8192 — розмір стека в байтах.
       NULL — параметри для функції (не використовуються).
       1 — пріоритет (0 — найнижчий, до 24 на ESP32).
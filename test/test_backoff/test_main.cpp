@@ -0,0 +1,44 @@
+// Тести повторних підключень до Wi-Fi (Backoff), опитування кожні 10 мс, як у webServerTask: затримка
+// подвоюється від BACKOFF_INITIAL_MS до BACKOFF_MAX_MS, а після втрати зв’язку відлік починається заново.
+//   pio test -e native -f test_backoff
+#include "Backoff.h"
+
+#include <unity.h>
+
+#include <vector>
+
+void setUp() {}
+void tearDown() {}
+
+// Wi-Fi без точки доступу 10 хв: 4, 12, 28 с і далі щохвилини (60..600 с) — 13 спроб
+static void test_delays_double_up_to_limit() {
+  Backoff backoff;
+  backoff.start(0);
+  std::vector<uint32_t> attempts;
+  for (uint32_t ms = 0; ms <= 10 * 60000; ms += 10)
+    if (backoff.due(ms)) {
+      backoff.attempt(ms);
+      attempts.push_back(ms);
+    }
+  const uint32_t expected[] = {4000, 12000, 28000, 60000, 120000, 180000};
+  TEST_ASSERT_EQUAL(13, attempts.size());
+  for (int i = 0; i < 6; i++) TEST_ASSERT_EQUAL_UINT32(expected[i], attempts[i]);
+}
+
+// Зв’язок був і зник — перша спроба знову через BACKOFF_INITIAL_MS
+static void test_restart() {
+  Backoff backoff;
+  backoff.start(0);
+  for (uint32_t ms = 0; ms <= 300000; ms += 10)
+    if (backoff.due(ms)) backoff.attempt(ms);
+  backoff.start(700000);
+  TEST_ASSERT_FALSE(backoff.due(700000 + BACKOFF_INITIAL_MS - 1));
+  TEST_ASSERT_TRUE(backoff.due(700000 + BACKOFF_INITIAL_MS));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_delays_double_up_to_limit);
+  RUN_TEST(test_restart);
+  return UNITY_END();
+}
@@ -0,0 +1,179 @@
+// Тести розкладки діапазонів BandMap: ваги бінів на межах (частка перекриття), нормалізація кожного
+// діапазону, межі логарифмічної, мел- і власної розкладки, відхилені межі, перехід на низькочастотне
+// FFT на LOW_BAND_CROSSOVER_HZ, використані біни (для Герцеля) і підсилення за замовчуванням.
+//   pio test -e native -f test_band_map
+#include "BandMap.h"
+
+#include <unity.h>
+
+#include <math.h>
+
+#define FULL_BINS (SAMPLES / 2 + 1)
+#define LOW_BINS (LOW_BAND_SAMPLES / 2 + 1)
+
+static BandMap map;
+static double bins[FULL_BINS], lowBins[LOW_BINS], bands[MAX_BANDS];
+
+void setUp() {
+  for (int k = 0; k < FULL_BINS; k++) bins[k] = 0;
+  for (int k = 0; k < LOW_BINS; k++) lowBins[k] = 0;
+}
+void tearDown() {}
+
+static double mel(double hz) { return 2595 * log10(1 + hz / 700); }
+
+// Вага біна k повного FFT у діапазоні band — рівень діапазону для спектра з одиницею лише в цьому біні
+static double weight(int k, int band, bool withLow = false) {
+  setUp();
+  bins[k] = 1;
+  map.apply(bins, bands, withLow ? lowBins : nullptr);
+  return bands[band];
+}
+
+static double lowWeight(int k, int band) {
+  setUp();
+  lowBins[k] = 1;
+  map.apply(bins, bands, lowBins);
+  return bands[band];
+}
+
+// Біни по 78.125 Гц: бін k покриває [k - 0.5, k + 0.5] * 78.125. Діапазон 100–300 Гц бере 0.22 біна 1,
+// біни 2 і 3 цілком і 0.34 біна 4 (разом 2.56), діапазон 300–500 — 0.66 біна 4, бін 5 і 0.9 біна 6 (теж 2.56)
+static void test_boundary_bins_split_by_overlap() {
+  static const double edges[] = {100, 300, 500};
+  TEST_ASSERT_TRUE(map.build(edges, 2));
+  TEST_ASSERT_FLOAT_WITHIN(1e-6, 0.22 / 2.56, weight(1, 0));
+  TEST_ASSERT_FLOAT_WITHIN(1e-6, 1 / 2.56, weight(2, 0));
+  TEST_ASSERT_FLOAT_WITHIN(1e-6, 1 / 2.56, weight(3, 0));
+  TEST_ASSERT_FLOAT_WITHIN(1e-6, 0.34 / 2.56, weight(4, 0));
+  TEST_ASSERT_FLOAT_WITHIN(1e-6, 0.66 / 2.56, weight(4, 1));
+  TEST_ASSERT_FLOAT_WITHIN(1e-6, 1 / 2.56, weight(5, 1));
+  TEST_ASSERT_FLOAT_WITHIN(1e-6, 0.9 / 2.56, weight(6, 1));
+  TEST_ASSERT_FLOAT_WITHIN(0, 0, weight(0, 0));
+  TEST_ASSERT_FLOAT_WITHIN(0, 0, weight(7, 1));
+  TEST_ASSERT_FLOAT_WITHIN(0, 0, weight(5, 0));
+}
+
+// Рівень — середнє, а не сума: на пласкому спектрі кожен діапазон дорівнює 1, хоч би скільки бінів займав
+static void test_bands_normalised() {
+  TEST_ASSERT_TRUE(map.build(BAND_SCALE_LOG, 6, 40, SAMPLING_FREQ / 2));
+  for (int k = 0; k < FULL_BINS; k++) bins[k] = 1;
+  for (int k = 0; k < LOW_BINS; k++) lowBins[k] = 1;
+  map.apply(bins, bands);
+  for (int b = 0; b < map.count(); b++) TEST_ASSERT_FLOAT_WITHIN(1e-6, 1, bands[b]);
+  map.apply(bins, bands, lowBins);
+  for (int b = 0; b < map.count(); b++) TEST_ASSERT_FLOAT_WITHIN(1e-6, 1, bands[b]);
+}
+
+static void test_scale_edges() {
+  TEST_ASSERT_TRUE(map.build(BAND_SCALE_LOG, 3, 40, 5000)); // відношення сусідніх меж — 5
+  static const double logEdges[] = {40, 200, 1000, 5000};
+  TEST_ASSERT_EQUAL_INT(3, map.count());
+  for (int b = 0; b < 3; b++) {
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, logEdges[b], map.lowHz(b));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, logEdges[b + 1], map.highHz(b));
+  }
+
+  TEST_ASSERT_TRUE(map.build(BAND_SCALE_MEL, 4, 100, 4000)); // рівні кроки за мел-шкалою
+  TEST_ASSERT_FLOAT_WITHIN(1e-6, 100, map.lowHz(0));
+  TEST_ASSERT_FLOAT_WITHIN(1e-6, 4000, map.highHz(3));
+  double step = (mel(4000) - mel(100)) / 4;
+  for (int b = 0; b < 4; b++) TEST_ASSERT_FLOAT_WITHIN(1e-6, step, mel(map.highHz(b)) - mel(map.lowHz(b)));
+  TEST_ASSERT_TRUE(map.highHz(0) - map.lowHz(0) < map.highHz(3) - map.lowHz(3)); // угорі ширші в герцах
+
+  static const double custom[] = {50, 120, 800, 2500, 4200};
+  TEST_ASSERT_TRUE(map.build(custom, 4));
+  TEST_ASSERT_EQUAL_INT(4, map.count());
+  for (int b = 0; b < 4; b++) {
+    TEST_ASSERT_FLOAT_WITHIN(0, custom[b], map.lowHz(b));
+    TEST_ASSERT_FLOAT_WITHIN(0, custom[b + 1], map.highHz(b));
+  }
+}
+
+// Неприпустимі межі відхиляються, а попередня розкладка лишається
+static void test_rejects_bad_edges() {
+  static const double edges[] = {100, 300, 500};
+  TEST_ASSERT_TRUE(map.build(edges, 2));
+  uint32_t revision = map.revision();
+
+  static const double aboveNyquist[] = {5100, 6000}; // жодного біна: вище SAMPLING_FREQ / 2 (+ пів біна)
+  static const double lastAboveNyquist[] = {1000, 5100, 6000};
+  static const double unordered[] = {100, 500, 300};
+  static const double repeated[] = {100, 300, 300};
+  static const double negative[] = {-10, 300};
+  TEST_ASSERT_FALSE(map.build(aboveNyquist, 1));
+  TEST_ASSERT_FALSE(map.build(lastAboveNyquist, 2));
+  TEST_ASSERT_FALSE(map.build(unordered, 2));
+  TEST_ASSERT_FALSE(map.build(repeated, 2));
+  TEST_ASSERT_FALSE(map.build(negative, 1));
+  TEST_ASSERT_FALSE(map.build(edges, 0));
+  TEST_ASSERT_FALSE(map.build(edges, MAX_BANDS + 1));
+  TEST_ASSERT_FALSE(map.build(BAND_SCALE_LOG, 3, 500, 100));
+  TEST_ASSERT_FALSE(map.build(BAND_SCALE_MEL, 3, 0, 1000));
+
+  TEST_ASSERT_EQUAL_UINT32(revision, map.revision());
+  TEST_ASSERT_EQUAL_INT(2, map.count());
+  TEST_ASSERT_FLOAT_WITHIN(0, 300, map.highHz(0));
+}
+
+// Діапазон 300–500 Гц з lowBins: до LOW_BAND_CROSSOVER_HZ (400 Гц) — біни по 19.53125 Гц низькочастотного FFT
+// (0.14 біна 15, біни 16–19, 0.98 біна 20 — разом 5.12), вище — 0.38 біна 5 і 0.9 біна 6 повного (1.28)
+static void test_low_fft_handoff_at_crossover() {
+  TEST_ASSERT_FLOAT_WITHIN(1e-9, 400, LOW_BAND_CROSSOVER_HZ);
+  static const double edges[] = {300, 500};
+  TEST_ASSERT_TRUE(map.build(edges, 1));
+  TEST_ASSERT_FLOAT_WITHIN(1e-6, 0.14 / 6.4, lowWeight(15, 0));
+  TEST_ASSERT_FLOAT_WITHIN(1e-6, 1 / 6.4, lowWeight(16, 0));
+  TEST_ASSERT_FLOAT_WITHIN(1e-6, 1 / 6.4, lowWeight(19, 0));
+  TEST_ASSERT_FLOAT_WITHIN(1e-6, 0.98 / 6.4, lowWeight(20, 0));
+  TEST_ASSERT_FLOAT_WITHIN(0, 0, lowWeight(21, 0)); // вище переходу низькочастотне FFT не бере участі
+  TEST_ASSERT_FLOAT_WITHIN(0, 0, weight(4, 0, true)); // нижче переходу повне FFT не бере участі
+  TEST_ASSERT_FLOAT_WITHIN(1e-6, 0.38 / 6.4, weight(5, 0, true));
+  TEST_ASSERT_FLOAT_WITHIN(1e-6, 0.9 / 6.4, weight(6, 0, true));
+  // без lowBins — лише повне FFT: 0.66 біна 4, бін 5 і 0.9 біна 6
+  TEST_ASSERT_FLOAT_WITHIN(1e-6, 0.66 / 2.56, weight(4, 0));
+  TEST_ASSERT_FLOAT_WITHIN(1e-6, 1 / 2.56, weight(5, 0));
+}
+
+// usedBins — біни taps без повторів, а applyUsed з їхніх амплітуд дає те саме, що apply з усього спектра
+static void test_used_bins() {
+  static const double edges[] = {100, 300, 500};
+  TEST_ASSERT_TRUE(map.build(edges, 2));
+  static const int expected[] = {1, 2, 3, 4, 5, 6};
+  TEST_ASSERT_EQUAL_INT(6, map.usedBinCount());
+  TEST_ASSERT_EQUAL_INT_ARRAY(expected, map.usedBins(), 6);
+  double amplitudes[FULL_BINS], used[MAX_BANDS];
+  for (int k = 0; k < FULL_BINS; k++) bins[k] = 1 + k * k % 7;
+  for (int j = 0; j < map.usedBinCount(); j++) amplitudes[j] = bins[map.usedBins()[j]];
+  map.apply(bins, bands);
+  map.applyUsed(amplitudes, used);
+  for (int b = 0; b < map.count(); b++) TEST_ASSERT_FLOAT_WITHIN(1e-12, bands[b], used[b]);
+}
+
+// GAIN_LOW, GAIN_MID і GAIN_HIGH — найнижчому, середньому (count/2) і найвищому діапазонам, тобто тим,
+// що стають ampR, ampG і ampB; кожен build розставляє їх заново під нову кількість діапазонів
+static void test_default_gains_follow_layout() {
+  TEST_ASSERT_TRUE(map.build(BAND_SCALE_LOG, 5, 40, 5000));
+  static const double five[] = {GAIN_LOW, GAIN_DEFAULT, GAIN_MID, GAIN_DEFAULT, GAIN_HIGH};
+  for (int b = 0; b < 5; b++) TEST_ASSERT_FLOAT_WITHIN(0, five[b], map.gain(b));
+  map.setGain(4, 300);
+  TEST_ASSERT_TRUE(map.build(BAND_SCALE_MEL, 8, 40, 5000));
+  TEST_ASSERT_FLOAT_WITHIN(0, GAIN_LOW, map.gain(0));
+  TEST_ASSERT_FLOAT_WITHIN(0, GAIN_DEFAULT, map.gain(4 - 1));
+  TEST_ASSERT_FLOAT_WITHIN(0, GAIN_MID, map.gain(4));
+  TEST_ASSERT_FLOAT_WITHIN(0, GAIN_HIGH, map.gain(7));
+  TEST_ASSERT_FALSE(map.build(BAND_SCALE_LOG, 0, 40, 5000)); // відхилена розкладка підсилень не чіпає
+  TEST_ASSERT_FLOAT_WITHIN(0, GAIN_HIGH, map.gain(7));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_boundary_bins_split_by_overlap);
+  RUN_TEST(test_bands_normalised);
+  RUN_TEST(test_scale_edges);
+  RUN_TEST(test_rejects_bad_edges);
+  RUN_TEST(test_low_fft_handoff_at_crossover);
+  RUN_TEST(test_used_bins);
+  RUN_TEST(test_default_gains_follow_layout);
+  return UNITY_END();
+}
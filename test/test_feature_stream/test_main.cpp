@@ -0,0 +1,50 @@
+// Тести трансляції ознак (/ws): кадри кодуються для "клієнта", що не встигає за кожним третім кадром
+// (йому кадр не надсилається); декодер має після кожного отриманого кадру мати ті самі квантовані рівні,
+// що й джерело. Ознаки — з конвеєра на синтетичному записі.
+//   pio test -e native -f test_feature_stream
+#include "AudioPipeline.h"
+#include "FeatureStream.h"
+#include "SyntheticSignal.h"
+
+#include <unity.h>
+
+#include <vector>
+
+static std::vector<AudioFeatures> features;
+
+void setUp() {
+  if (!features.empty()) return;
+  static AudioPipeline pipeline;
+  std::vector<int> samples = synthSamples(64);
+  for (size_t i = 0; i < samples.size() / SAMPLES; i++) features.push_back(pipeline.process(&samples[i * SAMPLES]));
+}
+void tearDown() {}
+
+static void test_decoder_tracks_source_with_drops() {
+  FeatureStreamEncoder encoder;
+  FeatureStreamDecoder decoder;
+  uint8_t buffer[STREAM_FRAME_MAX];
+  long sent = 0;
+  for (size_t i = 0; i < features.size() * 4; i++) {
+    if (i % 3 == 2) continue; // клієнт не встигає — кадр відкинуто, кодер не оновлюється
+    FeatureFrame frame = {};
+    frame.features = features[i % features.size()];
+    frame.mode = i % 7 + 1;
+    frame.sequence = i;
+    size_t size = encoder.encode(frame, buffer);
+    sent++;
+    TEST_ASSERT_LESS_OR_EQUAL_INT(STREAM_FRAME_MAX, size);
+    TEST_ASSERT_TRUE(decoder.decode(buffer, size));
+    TEST_ASSERT_EQUAL_INT(frame.mode, decoder.mode);
+    TEST_ASSERT_EQUAL_UINT16(i, decoder.sequence);
+    TEST_ASSERT_EQUAL_INT(frame.features.bandCount, decoder.bandCount);
+    for (int b = 0; b < decoder.bandCount; b++) TEST_ASSERT_EQUAL_INT(FeatureStreamEncoder::quantise(frame.features.bands[b]), decoder.bands[b]);
+  }
+  TEST_ASSERT_GREATER_THAN_INT(0, sent);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_decoder_tracks_source_with_drops);
+  return UNITY_END();
+}
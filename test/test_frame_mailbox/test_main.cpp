@@ -0,0 +1,89 @@
+// Тести комірки найсвіжішого кадру між задачами аналізу і світлодіодів: при HOP_MIN аналіз дає в
+// ~16 разів більше кадрів, ніж показують світлодіоди, — читач має отримувати найновіший кадр, а
+// замінені кадри не рахуються втраченими. Стрес-тест: писач без перерви, копії не розірвані і не йдуть назад.
+//   pio test -e native -f test_frame_mailbox
+#include "AudioPipeline.h"
+#include "FrameMailbox.h"
+#include "FrameScheduler.h"
+#include "SlidingWindow.h"
+
+#include <unity.h>
+
+#include <atomic>
+#include <thread>
+
+#define STRESS_FRAMES 1000000L
+#define READ_ATTEMPTS 4
+
+void setUp() {}
+void tearDown() {}
+
+static FeatureFrame makeFrame(uint32_t sequence) {
+  FeatureFrame frame = {};
+  frame.sequence = sequence;
+  frame.mode = sequence % 7 + 1;
+  frame.features.bandCount = MAX_BANDS;
+  for (int b = 0; b < MAX_BANDS; b++) frame.features.bands[b] = (double)sequence + b; // видно, якщо кадр розірвано
+  frame.features.avgEnergy = sequence;
+  return frame;
+}
+
+static bool torn(const FeatureFrame &frame) {
+  bool bad = frame.features.avgEnergy != frame.sequence || frame.mode != (int)(frame.sequence % 7 + 1);
+  for (int b = 0; b < MAX_BANDS; b++) bad |= frame.features.bands[b] != (double)frame.sequence + b;
+  return bad;
+}
+
+// Кадри аналізу при HOP_MIN між двома кадрами RENDER_FPS: показується останній, нічого не втрачено
+static void test_reader_gets_newest_frame() {
+  FrameMailbox<FeatureFrame> mailbox;
+  FeatureFrame frame;
+  TEST_ASSERT_FALSE(mailbox.take(frame, READ_ATTEMPTS)); // ще жодного кадру
+  const int perRender = SAMPLING_FREQ / HOP_MIN / RENDER_FPS + 1;
+  TEST_ASSERT_TRUE(perRender > 8); // стільки черга з 8 кадрів уже не вміщала
+  uint32_t sequence = 0;
+  for (int render = 0; render < 100; render++) {
+    for (int i = 0; i < perRender; i++) mailbox.publish(makeFrame(sequence++));
+    TEST_ASSERT_TRUE(mailbox.take(frame, READ_ATTEMPTS));
+    TEST_ASSERT_EQUAL_UINT32(sequence - 1, frame.sequence);
+    TEST_ASSERT_FALSE(mailbox.take(frame, READ_ATTEMPTS)); // нового кадру ще немає
+  }
+  TEST_ASSERT_EQUAL_UINT32(sequence, mailbox.published());
+  TEST_ASSERT_EQUAL_UINT32(0, mailbox.lost());
+}
+
+static void test_concurrent_frames_never_torn() {
+  FrameMailbox<FeatureFrame> mailbox;
+  std::atomic<bool> done(false);
+  long errors = 0, taken = 0;
+  std::thread writer([&] {
+    for (long i = 0; i < STRESS_FRAMES; i++) mailbox.publish(makeFrame(i));
+    done = true;
+  });
+  std::thread reader([&] {
+    FeatureFrame frame;
+    long last = -1;
+    while (!done) {
+      if (!mailbox.take(frame, READ_ATTEMPTS)) {
+        std::this_thread::yield();
+        continue;
+      }
+      taken++;
+      if (torn(frame) || (long)frame.sequence < last) errors++;
+      last = frame.sequence;
+    }
+    if (mailbox.take(frame, READ_ATTEMPTS) && (torn(frame) || frame.sequence != STRESS_FRAMES - 1)) errors++;
+  });
+  writer.join();
+  reader.join();
+  TEST_ASSERT_EQUAL_INT(0, errors);
+  TEST_ASSERT_TRUE(taken > 0);
+  TEST_ASSERT_EQUAL_UINT32(STRESS_FRAMES, mailbox.published());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_reader_gets_newest_frame);
+  RUN_TEST(test_concurrent_frames_never_torn);
+  return UNITY_END();
+}
@@ -0,0 +1,82 @@
+// Тести планувальника кадрів із фіктивним годинником: кадри задачі світлодіодів тривають задану кількість
+// мкс, сон — рівно стільки, скільки попросив планувальник (плюс похибка тіка). А також AnalysisThrottle:
+// кожен рівень деградації удвічі зменшує кількість кадрів аналізу (час цих кадрів показує бенчмарк).
+//   pio test -e native -f test_frame_scheduler
+#include "FrameScheduler.h"
+#include "SlidingWindow.h"
+
+#include <unity.h>
+
+void setUp() {}
+void tearDown() {}
+
+// Кадри різної тривалості (5–30 мс з 50): дедлайни не дрейфують — 1000 кадрів = рівно 50 с
+static void test_no_drift() {
+  FrameScheduler steady;
+  uint32_t now = 4294967295u - 200000; // відлік біля переповнення uint32 мкс (micros() на ESP32 — за 71 хв)
+  uint32_t begin = now;
+  for (int i = 0; i < 1000; i++) {
+    steady.frameStart(now);
+    now += 5000 + (i * 7919) % 25000;  // робота кадру
+    uint32_t sleep = steady.frameEnd(now);
+    now += (sleep + 999) / 1000 * 1000; // vTaskDelay округлює вгору до тіка (1 мс)
+  }
+  uint32_t elapsed = now - begin, expected = 1000 * steady.periodUs();
+  TEST_ASSERT_GREATER_OR_EQUAL_INT(expected, elapsed);
+  TEST_ASSERT_LESS_OR_EQUAL_INT(expected + 1000, elapsed);
+  TEST_ASSERT_EQUAL_UINT32(0, steady.overruns());
+}
+
+// Перевантаження (кадр 120 мс при періоді 50 мс), потім норма: перевищення враховані, пропущені
+// періоди відкинуті, рівень деградації зростає до максимуму і повертається до 0 після відновлення
+static void test_overload_and_recovery() {
+  FrameScheduler loaded;
+  uint32_t now = 0;
+  int peakLevel = 0;
+  for (int i = 0; i < 20; i++) {
+    loaded.frameStart(now);
+    now += 120000;
+    now += loaded.frameEnd(now);
+    if (loaded.level() > peakLevel) peakLevel = loaded.level();
+  }
+  TEST_ASSERT_EQUAL_UINT32(20, loaded.overruns());
+  TEST_ASSERT_EQUAL_UINT32(20, loaded.skippedPeriods());
+  TEST_ASSERT_EQUAL_INT(DEGRADE_MAX_LEVEL, peakLevel);
+  for (int i = 0; i < 3 * RECOVER_AFTER_FRAMES; i++) {
+    loaded.frameStart(now);
+    now += 5000;
+    now += loaded.frameEnd(now);
+  }
+  TEST_ASSERT_EQUAL_INT(0, loaded.level());
+}
+
+// Цикл задачі аналізу на секунду звуку: на рівні L аналізується кожен 2^L-й крок, а низькочастотна
+// гілка отримує всі зразки, що надійшли з попереднього проаналізованого кадру
+static void test_throttle_halves_frames() {
+  const int hops[] = {HOP_MIN, 48, SAMPLES};
+  for (int hop : hops) {
+    long previous = 0;
+    for (int level = 0; level <= DEGRADE_MAX_LEVEL; level++) {
+      AnalysisThrottle throttle;
+      long analysed = 0, samples = 0;
+      for (int at = 0; at + hop <= SAMPLING_FREQ; at += hop) {
+        if (!throttle.step(level, hop)) continue;
+        TEST_ASSERT_EQUAL_INT(hop << level, throttle.newSamples());
+        samples += throttle.newSamples();
+        analysed++;
+      }
+      TEST_ASSERT_EQUAL_INT(SAMPLING_FREQ / hop >> level, analysed);
+      TEST_ASSERT_LESS_OR_EQUAL_INT(SAMPLING_FREQ, samples);
+      if (level > 0) TEST_ASSERT_LESS_OR_EQUAL_INT(previous / 2 + 1, analysed);
+      previous = analysed;
+    }
+  }
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_no_drift);
+  RUN_TEST(test_overload_and_recovery);
+  RUN_TEST(test_throttle_halves_frames);
+  return UNITY_END();
+}
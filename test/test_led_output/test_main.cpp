@@ -0,0 +1,42 @@
+// Тести макета виводу на стрічки: байти кожної стрічки — GRB з урахуванням яскравості, як їх побачить
+// WS2812B, і при одночасному виводі (по каналу на стрічку), і по черзі; одночасний вивід не довший за
+// послідовний (сам час на дроті для 1..LED_OUTPUT_MAX_STRIPS стрічок друкує бенчмарк).
+//   pio test -e native -f test_led_output
+#include "MockLedOutput.h"
+
+#include <unity.h>
+
+void setUp() {}
+void tearDown() {}
+
+static uint8_t pixels[LED_OUTPUT_MAX_STRIPS][16 * 3];
+
+static void test_bytes_and_wire_time() {
+  for (int strips = 1; strips <= LED_OUTPUT_MAX_STRIPS; strips *= 2) {
+    MockLedOutput parallel(true), sequential(false);
+    for (int i = 0; i < strips; i++) {
+      for (int j = 0; j < 16 * 3; j++) pixels[i][j] = (uint8_t)(i * 31 + j * 7);
+      parallel.addStrip(i, pixels[i], 16);
+      sequential.addStrip(i, pixels[i], 16);
+    }
+    parallel.setBrightness(100);
+    parallel.showAll();
+    sequential.showAll();
+    for (int i = 0; i < strips; i++) {
+      TEST_ASSERT_EQUAL_UINT32(1, parallel.stripShows(i));
+      for (int led = 0; led < 16; led++) { // RGB у пам’яті -> GRB на дроті
+        TEST_ASSERT_EQUAL_UINT8(LedOutput::scale(pixels[i][3 * led + 1], 100), parallel.sent(i)[3 * led]);
+        TEST_ASSERT_EQUAL_UINT8(LedOutput::scale(pixels[i][3 * led], 100), parallel.sent(i)[3 * led + 1]);
+        TEST_ASSERT_EQUAL_UINT8(LedOutput::scale(pixels[i][3 * led + 2], 100), parallel.sent(i)[3 * led + 2]);
+      }
+    }
+    TEST_ASSERT_LESS_OR_EQUAL_INT(sequential.lastWireUs(), parallel.lastWireUs());
+    if (strips > 1) TEST_ASSERT_LESS_THAN_INT(sequential.lastWireUs(), parallel.lastWireUs());
+  }
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_bytes_and_wire_time);
+  return UNITY_END();
+}
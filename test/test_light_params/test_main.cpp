@@ -0,0 +1,64 @@
+// Тести /api/state: частковий PATCH змінює лише передані поля, помилка не змінює нічого, застаріла версія —
+// конфлікт, а GET-відповідь (lightParamsToJson) знову розбирається в той самий блок.
+//   pio test -e native -f test_light_params
+#include "LightParams.h"
+
+#include <unity.h>
+
+#include <string.h>
+
+static char error[96], json[384], check[384];
+static LightParams p;
+
+void setUp() {
+  p = defaultLightParams();
+  p.version = 7;
+}
+void tearDown() {}
+
+static PatchResult patch(const char *text, LightParams &target) { return patchLightParams(text, strlen(text), target, error, sizeof(error)); }
+
+static void test_partial_patch() {
+  TEST_ASSERT_EQUAL_INT(PATCH_OK, patch("{\"mode\": 5, \"thresholds\": [0.5, 1, 1.5], \"hop\": 1000}", p));
+  TEST_ASSERT_EQUAL_INT(5, p.mode);
+  TEST_ASSERT_FLOAT_WITHIN(0, 1, p.thresholds[1]);
+  TEST_ASSERT_EQUAL_INT(SAMPLES, p.hop); // обмежено як у SlidingWindow::clampHop
+  TEST_ASSERT_EQUAL_INT(SMOOTHING_FRAMES, p.smoothing);
+}
+
+// Блоки порівнюємо JSON-ом (без байтів вирівнювання)
+static void test_invalid_patch_changes_nothing() {
+  lightParamsToJson(p, json, sizeof(json));
+  static const char *bad[] = {"{\"mode\":5,\"colour\":1}", "{\"brightness\":300}", "{\"smoothing\":2.5}", "{\"gains\":[1]}", "{\"mode\":3", "[]",
+                              "{\"version\":-1,\"mode\":1}"};
+  for (const char *text : bad) {
+    TEST_ASSERT_EQUAL_INT_MESSAGE(PATCH_INVALID, patch(text, p), text);
+    lightParamsToJson(p, check, sizeof(check));
+    TEST_ASSERT_EQUAL_STRING(json, check);
+  }
+}
+
+static void test_stale_version_conflicts() {
+  TEST_ASSERT_EQUAL_INT(PATCH_OK, patch("{\"mode\": 5}", p));
+  TEST_ASSERT_EQUAL_INT(PATCH_CONFLICT, patch("{\"version\":6,\"mode\":1}", p));
+  TEST_ASSERT_EQUAL_INT(5, p.mode);
+}
+
+static void test_json_round_trip() {
+  TEST_ASSERT_EQUAL_INT(PATCH_OK, patch("{\"mode\": 5, \"thresholds\": [0.5, 1, 1.5], \"hop\": 1000}", p));
+  size_t length = lightParamsToJson(p, json, sizeof(json));
+  LightParams parsed = defaultLightParams();
+  parsed.version = p.version;
+  TEST_ASSERT_EQUAL_INT(PATCH_OK, patchLightParams(json, length, parsed, error, sizeof(error)));
+  lightParamsToJson(parsed, check, sizeof(check));
+  TEST_ASSERT_EQUAL_STRING(json, check);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_partial_patch);
+  RUN_TEST(test_invalid_patch_changes_nothing);
+  RUN_TEST(test_stale_version_conflicts);
+  RUN_TEST(test_json_round_trip);
+  return UNITY_END();
+}
@@ -0,0 +1,84 @@
+// Стрес-тест seqlock блоку параметрів: писач без перерви публікує нові версії, де кожне поле виводиться
+// з номера версії, а два читачі знімають копії без блокувань (як задачі аналізу і світлодіодів).
+// Розірвана копія — поля різних версій — має бути неможливою, а версії в читача — не йти назад.
+//   pio test -e native -f test_param_store
+#include "ParamStore.h"
+
+#include <unity.h>
+
+#include <atomic>
+#include <thread>
+
+#define STRESS_WRITES 1000000L
+
+void setUp() {}
+void tearDown() {}
+
+static ParamStore store;
+
+static bool consistent(const LightParams &p) {
+  uint32_t v = p.version;
+  if (v == 0) return true; // блок за замовчуванням
+  bool ok = p.mode == (int)(v % 7 + 1) && p.smoothing == (int)(v % SMOOTHING_MAX + 1) && p.brightness == (int)(v % 256) &&
+            p.hop == (int)v && p.fps == (int)~v;
+  for (int b = 0; b < MAX_BANDS; b++) ok &= p.gains[b] == (double)v + b;
+  for (int i = 0; i < 3; i++) ok &= p.thresholds[i] == (double)v * (i + 1);
+  return ok;
+}
+
+static void test_readers_never_see_torn_copies() {
+  std::atomic<bool> done(false);
+  std::atomic<long> torn(0), reads(0);
+  std::thread writer([&done] {
+    for (long i = 0; i < STRESS_WRITES; i++) {
+      store.update([](LightParams &p) {
+        uint32_t v = p.version + 1; // таку версію отримає блок
+        p.mode = v % 7 + 1;
+        p.smoothing = v % SMOOTHING_MAX + 1;
+        p.brightness = v % 256;
+        p.hop = v;
+        p.fps = ~v;
+        for (int b = 0; b < MAX_BANDS; b++) p.gains[b] = (double)v + b;
+        for (int k = 0; k < 3; k++) p.thresholds[k] = (double)v * (k + 1);
+        return true;
+      });
+    }
+    done = true;
+  });
+  auto reader = [&] {
+    LightParams copy;
+    uint32_t last = 0;
+    while (!done) {
+      if (!store.tryRead(copy)) continue; // писач заважав усі PARAM_READ_ATTEMPTS спроб
+      reads++;
+      if (!consistent(copy) || copy.version < last) torn++;
+      last = copy.version;
+    }
+  };
+  std::thread first(reader), second(reader);
+  writer.join();
+  first.join();
+  second.join();
+  TEST_ASSERT_EQUAL_INT(0, torn.load());
+  TEST_ASSERT_GREATER_THAN_INT(0, reads.load());
+  TEST_ASSERT_EQUAL_UINT32(STRESS_WRITES, store.version());
+  TEST_ASSERT_TRUE(consistent(store.read()));
+}
+
+// change повернула false — нічого не опубліковано, версія та сама
+static void test_rejected_update() {
+  ParamStore local;
+  TEST_ASSERT_FALSE(local.update([](LightParams &p) {
+    p.mode = 3;
+    return false;
+  }));
+  TEST_ASSERT_EQUAL_UINT32(0, local.version());
+  TEST_ASSERT_EQUAL_INT(defaultLightParams().mode, local.read().mode);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_rejected_update);
+  RUN_TEST(test_readers_never_see_torn_copies);
+  return UNITY_END();
+}
@@ -0,0 +1,100 @@
+// Тести злитого ядра кроків 1–4 (preprocessFrame): для double — біт у біт як покроковий еталон (і в
+// AudioPipeline::preprocess, разом із rawAmplitude), для float і фіксованої коми — у межах похибки
+// округлення. Кадри — із синтетичного запису і з аномальними зразками (зокрема першим).
+//   pio test -e native -f test_preprocess
+#include "AudioPipeline.h"
+#include "Preprocess.h"
+#include "SyntheticSignal.h"
+
+#include <unity.h>
+
+#include <algorithm>
+#include <math.h>
+#include <string.h>
+#include <vector>
+
+#define PREPROCESS_MAX_ERROR 0.01 // одиниць АЦП для float і int32_t
+
+static std::vector<int> frames;      // кадри з аномаліями
+static std::vector<double> expected; // результат еталона для кожного кадру
+
+// Кроки 1–4 так, як їх рахували раніше: копія кадру з корекцією аномалій, сума, віднімання
+// середнього, IIR в окремий масив і копія назад
+static void referencePreprocess(const int *samples, double *vReal) {
+  for (int i = 0; i < SAMPLES; i++) {
+    vReal[i] = samples[i];
+    if (vReal[i] < 0 || vReal[i] > ADC_MAX) vReal[i] = (i > 0) ? vReal[i - 1] : ADC_MID;
+  }
+  double mean = 0;
+  for (int i = 0; i < SAMPLES; i++) mean += vReal[i];
+  mean /= SAMPLES;
+  for (int i = 0; i < SAMPLES; i++) vReal[i] -= mean;
+  double filtered[SAMPLES];
+  filtered[0] = vReal[0];
+  for (int i = 1; i < SAMPLES; i++) filtered[i] = IIR_FEEDBACK * filtered[i - 1] + IIR_INPUT * vReal[i];
+  for (int i = 0; i < SAMPLES; i++) vReal[i] = filtered[i];
+}
+
+void setUp() {
+  if (!frames.empty()) return;
+  frames = synthSamples(64);
+  for (size_t f = 0; f < frames.size() / SAMPLES; f += 3) { // аномалії в кожному третьому кадрі
+    int *frame = &frames[f * SAMPLES];
+    frame[0] = -7;
+    frame[(f * 31 + 5) % SAMPLES] = ADC_MAX + 100;
+    frame[(f * 17 + 64) % SAMPLES] = -1;
+  }
+  expected.resize(frames.size());
+  for (size_t f = 0; f < frames.size() / SAMPLES; f++) referencePreprocess(&frames[f * SAMPLES], &expected[f * SAMPLES]);
+}
+void tearDown() {}
+
+static void test_double_bit_exact() {
+  double fused[SAMPLES];
+  for (size_t f = 0; f < frames.size() / SAMPLES; f++) {
+    preprocessFrame(&frames[f * SAMPLES], fused, SAMPLES);
+    TEST_ASSERT_EQUAL_MEMORY(&expected[f * SAMPLES], fused, sizeof(fused));
+  }
+}
+
+// Конвеєр викликає те саме ядро; rawAmplitude — як раніше з копії "сирих" даних
+static void test_pipeline_preprocess() {
+  static AudioPipeline pipeline;
+  pipeline.setFeatures(FEATURE_ALL | FEATURE_RAW);
+  for (size_t f = 0; f < frames.size() / SAMPLES; f++) {
+    const int *frame = &frames[f * SAMPLES];
+    pipeline.preprocess(frame);
+    TEST_ASSERT_EQUAL_MEMORY(&expected[f * SAMPLES], pipeline.timeDomain(), SAMPLES * sizeof(double));
+    double rawMean = 0, rawDeviation = 0;
+    for (int i = 0; i < SAMPLES; i++) rawMean += (double)frame[i];
+    rawMean /= SAMPLES;
+    for (int i = 0; i < SAMPLES; i++) rawDeviation += fabs((double)frame[i] - rawMean);
+    rawDeviation /= SAMPLES;
+    TEST_ASSERT_TRUE(pipeline.rawAmplitude() == rawDeviation);
+  }
+}
+
+// Найбільша різниця ядра з типом T від еталона (в одиницях АЦП) на всіх кадрах
+template <typename T> static double preprocessError() {
+  T out[SAMPLES];
+  double maxError = 0;
+  for (size_t f = 0; f < frames.size() / SAMPLES; f++) {
+    preprocessFrame(&frames[f * SAMPLES], out, SAMPLES);
+    for (int i = 0; i < SAMPLES; i++)
+      maxError = std::max(maxError, fabs(PreprocessMath<T>::toDouble(out[i]) - expected[f * SAMPLES + i]));
+  }
+  return maxError;
+}
+
+static void test_float_within_rounding() { TEST_ASSERT_FLOAT_WITHIN(PREPROCESS_MAX_ERROR, 0, preprocessError<float>()); }
+
+static void test_fixed_point_within_rounding() { TEST_ASSERT_FLOAT_WITHIN(PREPROCESS_MAX_ERROR, 0, preprocessError<int32_t>()); }
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_double_bit_exact);
+  RUN_TEST(test_pipeline_preprocess);
+  RUN_TEST(test_float_within_rounding);
+  RUN_TEST(test_fixed_point_within_rounding);
+  return UNITY_END();
+}
@@ -0,0 +1,69 @@
+// Тести гістограми часу етапів (Profiler.h). Класи профілювання компілюються лише з AUDIO_PROFILING:
+//   PLATFORMIO_BUILD_FLAGS="-D AUDIO_PROFILING=1" pio test -e native -f test_profiler
+// без прапорця тести пропускаються.
+#include "Profiler.h"
+
+#include <unity.h>
+
+#include <string.h>
+
+void setUp() {}
+void tearDown() {}
+
+// Рівномірні 1..10000 мкс: точний p99 = 9900 мкс має потрапити в межі свого кошика
+static void test_p99_within_bucket() {
+#if AUDIO_PROFILING
+  StageStats stats;
+  for (uint32_t us = 1; us <= 10000; us++) stats.add(us * 1000);
+  uint32_t p99 = stats.percentileNs(99);
+  TEST_ASSERT_GREATER_OR_EQUAL_INT(9900000, p99);
+  TEST_ASSERT_LESS_OR_EQUAL_INT(StageStats::bucketUpperNs(StageStats::bucketOf(9900000)), p99);
+  TEST_ASSERT_EQUAL_UINT32(1000, stats.minNs());
+  TEST_ASSERT_EQUAL_UINT32(10000000, stats.maxNs());
+  TEST_ASSERT_EQUAL_UINT32(5000500, stats.avgNs());
+#else
+  TEST_IGNORE_MESSAGE("зібрано без AUDIO_PROFILING");
+#endif
+}
+
+// Межі кошиків зростають монотонно, і кожен вимір лежить не вище верхньої межі свого кошика
+static void test_buckets_cover_range() {
+#if AUDIO_PROFILING
+  for (int b = 1; b < PROFILE_BUCKETS; b++) TEST_ASSERT_LESS_THAN_INT(StageStats::bucketUpperNs(b), StageStats::bucketUpperNs(b - 1));
+  for (uint32_t ns = 1; ns < 60000000; ns = ns * 5 / 4 + 1) TEST_ASSERT_LESS_OR_EQUAL_INT(StageStats::bucketUpperNs(StageStats::bucketOf(ns)), ns);
+#else
+  TEST_IGNORE_MESSAGE("зібрано без AUDIO_PROFILING");
+#endif
+}
+
+// /profile?reset з іншої задачі лише просить обнулити: етап починається заново з наступного виміру
+// задачі-власника, а до того звіт його не показує
+static void test_reset_request_consumed_by_writer() {
+#if AUDIO_PROFILING
+  char report[1024];
+  Profiler::reset();
+  for (int i = 0; i < 10; i++) Profiler::record(PROFILE_FFT, 5 * PROFILE_TICKS_PER_US);
+  Profiler::record(PROFILE_SHOW, 7 * PROFILE_TICKS_PER_US);
+  Profiler::requestReset();
+  TEST_ASSERT_EQUAL_UINT32(10, Profiler::stage(PROFILE_FFT).count()); // сама статистика — ще не змінена
+  Profiler::report(report, sizeof(report));
+  TEST_ASSERT_NULL(strstr(report, Profiler::name(PROFILE_FFT)));
+  Profiler::record(PROFILE_FFT, 3 * PROFILE_TICKS_PER_US);
+  TEST_ASSERT_EQUAL_UINT32(1, Profiler::stage(PROFILE_FFT).count());
+  TEST_ASSERT_EQUAL_UINT32(3000, Profiler::stage(PROFILE_FFT).maxNs());
+  Profiler::report(report, sizeof(report));
+  TEST_ASSERT_NOT_NULL(strstr(report, Profiler::name(PROFILE_FFT)));
+  TEST_ASSERT_NULL(strstr(report, Profiler::name(PROFILE_SHOW))); // етап ще не записувався після запиту
+  TEST_ASSERT_EQUAL_UINT32(1, Profiler::stage(PROFILE_SHOW).count());
+#else
+  TEST_IGNORE_MESSAGE("зібрано без AUDIO_PROFILING");
+#endif
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_p99_within_bucket);
+  RUN_TEST(test_buckets_cover_range);
+  RUN_TEST(test_reset_request_consumed_by_writer);
+  return UNITY_END();
+}
@@ -0,0 +1,74 @@
+// Тести ковзного вікна: межі кроку (clampHop), момент першого кадру і вміст кадрів — у потоці 0, 1, 2, ...
+// кадр після n зразків має бути рівно [n - SAMPLES, n), а сусідні кадри — перекриватися на SAMPLES - hop.
+//   pio test -e native -f test_sliding_window
+#include "SlidingWindow.h"
+
+#include <unity.h>
+
+#include <string.h>
+#include <vector>
+
+void setUp() {}
+void tearDown() {}
+
+static void test_clamp_hop() {
+  TEST_ASSERT_EQUAL_INT(HOP_MIN, SlidingWindow::clampHop(-5));
+  TEST_ASSERT_EQUAL_INT(HOP_MIN, SlidingWindow::clampHop(0));
+  TEST_ASSERT_EQUAL_INT(HOP_MIN, SlidingWindow::clampHop(HOP_MIN - 1));
+  TEST_ASSERT_EQUAL_INT(HOP_MIN, SlidingWindow::clampHop(HOP_MIN));
+  TEST_ASSERT_EQUAL_INT(SAMPLES, SlidingWindow::clampHop(SAMPLES));
+  TEST_ASSERT_EQUAL_INT(SAMPLES, SlidingWindow::clampHop(SAMPLES + 1));
+  TEST_ASSERT_EQUAL_INT(SAMPLES, SlidingWindow::clampHop(SAMPLES << 2)); // так рівень деградації не може збільшити крок
+  TEST_ASSERT_EQUAL_INT(SAMPLES, SlidingWindow(1000).hop());
+  TEST_ASSERT_EQUAL_INT(HOP_MIN, SlidingWindow(1).hop());
+  TEST_ASSERT_EQUAL_INT(0, SlidingWindow::overlapPercent(SAMPLES));
+  TEST_ASSERT_EQUAL_INT(50, SlidingWindow::overlapPercent(SAMPLES / 2));
+}
+
+static void test_frames_follow_stream() {
+  const int hops[] = {HOP_MIN, 48, SAMPLES / 2, SAMPLES};
+  for (int hop : hops) {
+    SlidingWindow window(hop);
+    std::vector<int> block(hop);
+    int frame[SAMPLES], previous[SAMPLES];
+    int next = 0, produced = 0;
+    for (int step = 0; step < 4 * SAMPLES / hop + 4; step++) {
+      for (int i = 0; i < hop; i++) block[i] = next++;
+      window.push(block.data(), hop);
+      TEST_ASSERT_EQUAL(next >= SAMPLES, window.ready()); // перший кадр — щойно назбиралось SAMPLES зразків, далі — кожен крок
+      if (!window.ready()) continue;
+      window.frame(frame);
+      TEST_ASSERT_FALSE(window.ready()); // крок уже забрано
+      for (int i = 0; i < SAMPLES; i++) TEST_ASSERT_EQUAL_INT(next - SAMPLES + i, frame[i]);
+      if (produced++ > 0) TEST_ASSERT_EQUAL_INT_ARRAY(previous + hop, frame, SAMPLES - hop);
+      memcpy(previous, frame, sizeof(frame));
+    }
+    TEST_ASSERT_GREATER_THAN_INT(4, produced);
+  }
+}
+
+// Крок змінено на льоту (як з /api/state): наступний кадр — після нового кроку
+static void test_hop_change() {
+  SlidingWindow window(SAMPLES);
+  std::vector<int> stream(3 * SAMPLES);
+  for (size_t i = 0; i < stream.size(); i++) stream[i] = i;
+  int frame[SAMPLES];
+  window.push(stream.data(), SAMPLES);
+  window.frame(frame);
+  window.setHop(HOP_MIN);
+  window.push(stream.data() + SAMPLES, HOP_MIN - 1);
+  TEST_ASSERT_FALSE(window.ready());
+  window.push(stream.data() + SAMPLES + HOP_MIN - 1, 1);
+  TEST_ASSERT_TRUE(window.ready());
+  window.frame(frame);
+  TEST_ASSERT_EQUAL_INT(HOP_MIN, frame[0]);
+  TEST_ASSERT_EQUAL_INT(SAMPLES + HOP_MIN - 1, frame[SAMPLES - 1]);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_clamp_hop);
+  RUN_TEST(test_frames_follow_stream);
+  RUN_TEST(test_hop_change);
+  return UNITY_END();
+}
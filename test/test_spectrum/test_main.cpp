@@ -0,0 +1,226 @@
+// Тести спектра конвеєра: таблиця вікна проти cos(), варіанти FFT (SPECTRUM_TYPE) проти double,
+// алгоритм Герцеля проти FFT, FEATURE_BAND_LEVEL проти повного FFT, "сирі" діапазони без другого FFT
+// і низькочастотна гілка (баси).
+// Сигнал — синтетичний запис (SyntheticSignal.h) і чисті тони.
+//   pio test -e native -f test_spectrum
+#include "AudioPipeline.h"
+#include "SyntheticSignal.h"
+
+#include <unity.h>
+
+#include <algorithm>
+#include <math.h>
+#include <type_traits>
+#include <vector>
+
+// computeRawBands наближений (див. AudioPipeline.cpp): найбільше допустиме відхилення його діапазонів від
+// окремого FFT "сирих" даних, частка найбільшого діапазону кадру (на синтетичному сигналі — ~5.5%)
+#define RAW_BANDS_MAX_ERROR 0.10
+
+static std::vector<int> samples;            // синтетичний запис
+static std::vector<double> windowed;        // його кадри після кроків 1–5 (DC, IIR, вікно Хеммінга)
+static std::vector<AudioFeatures> reference; // діапазони кожного кадру зі спектра double
+static AudioPipeline pipeline;
+
+static int frames() { return samples.size() / SAMPLES; }
+
+void setUp() {
+  if (!samples.empty()) return;
+  samples = synthSamples(64);
+  for (int i = 0; i < frames(); i++) {
+    pipeline.preprocess(&samples[i * SAMPLES]);
+    pipeline.computeSpectrum();
+    windowed.insert(windowed.end(), pipeline.timeDomain(), pipeline.timeDomain() + SAMPLES);
+    RealFft<SAMPLES, double> exact;
+    double bins[SPECTRUM_BINS];
+    exact.magnitudes(pipeline.timeDomain(), bins);
+    AudioFeatures f;
+    pipeline.bandsFromSpectrum(bins, f);
+    reference.push_back(f);
+  }
+}
+void tearDown() {}
+
+// Віконування так, як його робила бібліотека arduinoFFT на кожному кадрі: cos() для кожної пари зразків
+static void test_window_table_matches_cos() {
+  double maxError = 0;
+  for (int i = 0; i < frames(); i++) {
+    double trig[SAMPLES], table[SAMPLES];
+    for (int j = 0; j < SAMPLES; j++) trig[j] = table[j] = samples[i * SAMPLES + j] - ADC_MID;
+    for (int j = 0; j < SAMPLES / 2; j++) {
+      double weight = 0.54 - 0.46 * cos(2 * M_PI * j / (SAMPLES - 1));
+      trig[j] *= weight;
+      trig[SAMPLES - 1 - j] *= weight;
+    }
+    applyWindow<SAMPLES, WINDOW_HAMMING>(table);
+    for (int j = 0; j < SAMPLES; j++) maxError = std::max(maxError, fabs(trig[j] - table[j]));
+  }
+  TEST_ASSERT_FLOAT_WITHIN(1e-9, 0, maxError);
+}
+
+// Точність одного варіанта FFT відносно еталонного double: ampR/ampG/ampB (одиниці яскравості)
+// і avgEnergy (частка) не далі за межі цього типу
+template <typename T> static void checkBackend(int maxAmp, double maxEnergy) {
+  RealFft<SAMPLES, T> fft;
+  double bins[SPECTRUM_BINS];
+  int maxAmpError = 0;
+  double maxEnergyError = 0;
+  for (int i = 0; i < frames(); i++) {
+    fft.magnitudes(&windowed[i * SAMPLES], bins);
+    AudioFeatures f;
+    pipeline.bandsFromSpectrum(bins, f);
+    const AudioFeatures &ref = reference[i];
+    maxAmpError = std::max(maxAmpError, std::max(abs(f.ampR - ref.ampR), std::max(abs(f.ampG - ref.ampG), abs(f.ampB - ref.ampB))));
+    if (ref.avgEnergy > 0) maxEnergyError = std::max(maxEnergyError, fabs(f.avgEnergy - ref.avgEnergy) / ref.avgEnergy);
+  }
+  TEST_ASSERT_LESS_OR_EQUAL_INT(maxAmp, maxAmpError);
+  TEST_ASSERT_FLOAT_WITHIN(maxEnergy, 0, maxEnergyError);
+}
+
+// Межі: double — той самий код, що й еталон; float і Q31 — похибка округлення (зараз ~1e-7);
+// Q15 — 15 біт на все FFT з масштабуванням на кожному етапі (зараз до 22 одиниць і ~1.4%)
+static void test_backend_double() { checkBackend<double>(0, 1e-12); }
+static void test_backend_float() { checkBackend<float>(1, 1e-5); }
+static void test_backend_q31() { checkBackend<int32_t>(1, 1e-5); }
+static void test_backend_q15() { checkBackend<int16_t>(32, 3e-2); }
+
+// Окремі біни Герцелем — ті самі амплітуди, що й у FFT: для double — до похибки округлення, для
+// інших SPECTRUM_TYPE — до 1% найбільшого біна (обидва алгоритми округлюють по-своєму)
+static void test_goertzel_matches_fft() {
+  const double tolerance = std::is_same<SPECTRUM_TYPE, double>::value ? 1e-9 : 1e-2;
+  RealFft<SAMPLES, SPECTRUM_TYPE> fft;
+  double bins[SPECTRUM_BINS], peak = 0, maxError = 0;
+  for (int i = 0; i < frames(); i++) {
+    fft.magnitudes(&windowed[i * SAMPLES], bins);
+    for (int k = 0; k < SPECTRUM_BINS; k++) {
+      peak = std::max(peak, bins[k]);
+      maxError = std::max(maxError, fabs(Goertzel<SAMPLES, SPECTRUM_TYPE>::magnitude(&windowed[i * SAMPLES], k) - bins[k]));
+    }
+  }
+  TEST_ASSERT_FLOAT_WITHIN(tolerance * peak, 0, maxError);
+}
+
+// Обидва конвеєри — на тих самих кадрах чистого тону hz; найбільша різниця їхніх діапазонів,
+// частка найбільшого діапазону bands конвеєра level
+static double bandLevelError(AudioPipeline &level, AudioPipeline &full, double hz) {
+  const int frameCount = LOW_BAND_DECIMATION * LOW_BAND_SAMPLES / SAMPLES + 2; // поки заповниться кільце проріджених зразків
+  long n = 0;
+  for (int f = 0; f < frameCount; f++, n += SAMPLES) {
+    std::vector<int> tone = toneSamples(hz, SAMPLES, 800, n);
+    level.process(tone.data());
+    full.process(tone.data());
+  }
+  const AudioFeatures &a = level.features(), &b = full.features();
+  TEST_ASSERT_EQUAL_INT(b.bandCount, a.bandCount);
+  double peak = *std::max_element(a.bands, a.bands + a.bandCount), maxError = 0;
+  for (int k = 0; k < a.bandCount; k++) maxError = std::max(maxError, fabs(a.bands[k] - b.bands[k]));
+  TEST_ASSERT_TRUE(peak > 0);
+  return maxError / peak;
+}
+
+// FEATURE_BAND_LEVEL (mode 6, 7) з розкладкою за замовчуванням: тон у кожному діапазоні — ті самі рівні, що й
+// у FEATURE_ALL, і найгучніший саме діапазон тону (розкладка займає більше GOERTZEL_MAX_BINS бінів — отже, FFT)
+static void test_band_level_matches_fft() {
+  AudioPipeline probe;
+  for (int band = 0; band < probe.bandMap().count(); band++) {
+    AudioPipeline level, full;
+    level.setFeatures(FEATURE_ENERGY | FEATURE_BAND_LEVEL);
+    double hz = sqrt(level.bandMap().lowHz(band) * level.bandMap().highHz(band)); // середина діапазону в октавах
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 0, bandLevelError(level, full, hz));
+    TEST_ASSERT_EQUAL_INT(SPECTRUM_FFT, level.spectrumMethod());
+    const AudioFeatures &f = level.features();
+    TEST_ASSERT_EQUAL_INT(band, std::max_element(f.bands, f.bands + f.bandCount) - f.bands);
+  }
+}
+
+// Вузька розкладка (кілька бінів вище LOW_BAND_CROSSOVER_HZ) — FEATURE_BAND_LEVEL рахує лише її біни
+// Герцелем, а рівні ті самі, що й з FFT (з похибкою, як у test_goertzel_matches_fft). Змінена розкладка
+// перемикає спосіб на наступному кадрі, без повторного setFeatures
+static void test_band_level_goertzel_layout() {
+  const double tolerance = std::is_same<SPECTRUM_TYPE, double>::value ? 1e-9 : 1e-2;
+  static const double edges[] = {700, 800, 900};
+  static const double tones[] = {750, 850};
+  for (double hz : tones) {
+    AudioPipeline level, full;
+    level.setFeatures(FEATURE_ENERGY | FEATURE_BAND_LEVEL);
+    TEST_ASSERT_EQUAL_INT(SPECTRUM_FFT, level.spectrumMethod());
+    TEST_ASSERT_TRUE(level.bandMap().build(edges, 2));
+    TEST_ASSERT_TRUE(full.bandMap().build(edges, 2));
+    TEST_ASSERT_LESS_OR_EQUAL_INT(GOERTZEL_MAX_BINS, level.bandMap().usedBinCount());
+    TEST_ASSERT_FLOAT_WITHIN(tolerance, 0, bandLevelError(level, full, hz));
+    TEST_ASSERT_EQUAL_INT(SPECTRUM_GOERTZEL, level.spectrumMethod());
+  }
+  AudioPipeline level;
+  level.setFeatures(FEATURE_ENERGY | FEATURE_BAND_LEVEL);
+  TEST_ASSERT_TRUE(level.bandMap().build(edges, 2));
+  level.process(toneSamples(750, SAMPLES).data());
+  TEST_ASSERT_EQUAL_INT(SPECTRUM_GOERTZEL, level.spectrumMethod());
+  TEST_ASSERT_TRUE(level.bandMap().build(BAND_SCALE, BAND_COUNT, BAND_MIN_HZ, BAND_MAX_HZ));
+  level.process(toneSamples(750, SAMPLES).data());
+  TEST_ASSERT_EQUAL_INT(SPECTRUM_FFT, level.spectrumMethod());
+}
+
+// "Сирі" діапазони mode 5 так, як їх рахували раніше: окреме FFT необроблених даних (еталон для
+// computeRawBands, який відновлює їх зі спектра фільтрованого сигналу без другого FFT)
+static BandAmps exactRawBands(const int *frame) {
+  RealFft<SAMPLES, SPECTRUM_TYPE> fft;
+  double raw[SAMPLES], bins[SPECTRUM_BINS], mean = 0;
+  for (int i = 0; i < SAMPLES; i++) mean += frame[i];
+  mean /= SAMPLES;
+  for (int i = 0; i < SAMPLES; i++) raw[i] = frame[i] - mean;
+  applyWindow<SAMPLES, SPECTRUM_WINDOW>(raw);
+  fft.magnitudes(raw, bins);
+  AudioFeatures out;
+  pipeline.bandsFromSpectrum(bins, out);
+  BandAmps amps = {out.bands[0], out.bands[out.bandCount / 2], out.bands[out.bandCount - 1]};
+  return amps;
+}
+
+static void test_raw_bands_without_second_fft() {
+  AudioPipeline probe;
+  double maxError = 0; // найбільша різниця діапазонів відносно найбільшого діапазону кадру
+  for (int i = 0; i < frames(); i++) {
+    probe.process(&samples[i * SAMPLES]);
+    BandAmps exact = exactRawBands(&samples[i * SAMPLES]), fast = probe.computeRawBands();
+    double peak = std::max(exact.r, std::max(exact.g, exact.b));
+    double diff = std::max(fabs(fast.r - exact.r), std::max(fabs(fast.g - exact.g), fabs(fast.b - exact.b)));
+    if (peak > 0) maxError = std::max(maxError, diff / peak);
+  }
+  TEST_ASSERT_FLOAT_WITHIN(RAW_BANDS_MAX_ERROR, 0, maxError);
+}
+
+// Низькочастотна гілка: біни проріджених зразків у LOW_BAND_DECIMATION * LOW_BAND_SAMPLES / SAMPLES разів
+// вужчі, а пік чистого тону — у найближчому до тону біні обох FFT (не далі половини біна)
+static void test_bass_resolution() {
+  const double fullBinHz = (double)SAMPLING_FREQ / SAMPLES, lowBinHz = (double)LOW_BAND_RATE / LOW_BAND_SAMPLES;
+  TEST_ASSERT_FLOAT_WITHIN(1e-9, fullBinHz, lowBinHz * LOW_BAND_DECIMATION * LOW_BAND_SAMPLES / SAMPLES);
+  TEST_ASSERT_TRUE(lowBinHz < fullBinHz);
+  static const double tones[] = {60, 100, 140, 230, 330};
+  for (double tone : tones) {
+    AudioPipeline probe;
+    long n = 0;
+    for (int f = 0; f < LOW_BAND_DECIMATION * LOW_BAND_SAMPLES / SAMPLES + 2; f++, n += SAMPLES) // поки заповниться кільце проріджених зразків
+      probe.process(toneSamples(tone, SAMPLES, 800, n).data());
+    const double *full = probe.spectrum(), *low = probe.lowSpectrum();
+    TEST_ASSERT_NOT_NULL(low);
+    int fullPeak = std::max_element(full + 1, full + SPECTRUM_BINS) - full;
+    int lowPeak = std::max_element(low + 1, low + LOW_BAND_BINS) - low;
+    TEST_ASSERT_FLOAT_WITHIN(fullBinHz / 2, tone, fullPeak * fullBinHz);
+    TEST_ASSERT_FLOAT_WITHIN(lowBinHz / 2, tone, lowPeak * lowBinHz);
+  }
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_window_table_matches_cos);
+  RUN_TEST(test_backend_double);
+  RUN_TEST(test_backend_float);
+  RUN_TEST(test_backend_q31);
+  RUN_TEST(test_backend_q15);
+  RUN_TEST(test_goertzel_matches_fft);
+  RUN_TEST(test_band_level_matches_fft);
+  RUN_TEST(test_band_level_goertzel_layout);
+  RUN_TEST(test_raw_bands_without_second_fft);
+  RUN_TEST(test_bass_resolution);
+  return UNITY_END();
+}
@@ -0,0 +1,68 @@
+// Стрес-тест черги між задачами аналізу і світлодіодів: виробник і споживач у різних потоках.
+// Кадри мають приходити по порядку, без пропусків і без "розірваних" (частково записаних) даних.
+//   pio test -e native -f test_spsc_queue
+#include "AudioPipeline.h"
+#include "SpscQueue.h"
+
+#include <unity.h>
+
+#include <thread>
+
+#define STRESS_FRAMES 1000000L
+
+void setUp() {}
+void tearDown() {}
+
+static SpscQueue<FeatureFrame, 8> queue;
+
+static void test_fifo_without_loss_or_tearing() {
+  long errors = 0;
+  std::thread producer([] {
+    for (long i = 0; i < STRESS_FRAMES; i++) {
+      FeatureFrame frame = {};
+      frame.sequence = i;
+      frame.mode = i % 7 + 1;
+      frame.features.bandCount = MAX_BANDS;
+      for (int b = 0; b < MAX_BANDS; b++) frame.features.bands[b] = i + b; // узгоджений вміст: видно, якщо кадр розірвано
+      frame.features.avgEnergy = i;
+      while (!queue.push(frame)) std::this_thread::yield(); // черга повна — споживач ще не встиг (на одноядерній машині)
+    }
+  });
+  std::thread consumer([&errors] {
+    FeatureFrame frame;
+    for (long expected = 0; expected < STRESS_FRAMES;) {
+      if (!queue.pop(frame)) {
+        std::this_thread::yield();
+        continue;
+      }
+      bool torn = frame.features.avgEnergy != frame.sequence || frame.mode != (long)frame.sequence % 7 + 1;
+      for (int b = 0; b < MAX_BANDS; b++) torn |= frame.features.bands[b] != (double)frame.sequence + b;
+      if (torn || frame.sequence != (uint32_t)expected) errors++;
+      expected = frame.sequence + 1;
+    }
+  });
+  producer.join();
+  consumer.join();
+  TEST_ASSERT_EQUAL_INT(0, errors);
+  TEST_ASSERT_EQUAL(0, queue.size());
+}
+
+static void test_full_and_empty() {
+  SpscQueue<int, 4> small;
+  int value = 0;
+  TEST_ASSERT_FALSE(small.pop(value));
+  for (int i = 0; i < 4; i++) TEST_ASSERT_TRUE(small.push(i));
+  TEST_ASSERT_FALSE(small.push(4)); // повна: новий елемент не затирає старі
+  for (int i = 0; i < 4; i++) {
+    TEST_ASSERT_TRUE(small.pop(value));
+    TEST_ASSERT_EQUAL_INT(i, value);
+  }
+  TEST_ASSERT_FALSE(small.pop(value));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_full_and_empty);
+  RUN_TEST(test_fifo_without_loss_or_tearing);
+  return UNITY_END();
+}
@@ -0,0 +1,69 @@
+// Тести StripTracker: незмінені стрічки не передаються повторно, зміна одного пікселя позначає лише
+// його стрічку, invalidate (зміна яскравості) і attach змушують передати стрічки знову.
+//   pio test -e native -f test_strip_tracker
+#include "StripTracker.h"
+
+#include <unity.h>
+
+#include <string.h>
+
+#define STRIPS 4
+#define PIXELS 60
+
+static uint8_t leds[STRIPS][PIXELS * 3]; // RGB, як CRGB у FastLED
+static StripTracker<STRIPS> tracker;
+
+void setUp() {
+  memset(leds, 0, sizeof(leds));
+  tracker = StripTracker<STRIPS>();
+  for (int i = 0; i < STRIPS; i++) tracker.attach(i, leds[i], sizeof(leds[i]));
+}
+void tearDown() {}
+
+static void test_fnv1a_reference_values() {
+  TEST_ASSERT_EQUAL_UINT32(0x811c9dc5u, StripTracker<STRIPS>::hash((const uint8_t *)"", 0));
+  TEST_ASSERT_EQUAL_UINT32(0xe40c292cu, StripTracker<STRIPS>::hash((const uint8_t *)"a", 1));
+  TEST_ASSERT_EQUAL_UINT32(0xbf9cf968u, StripTracker<STRIPS>::hash((const uint8_t *)"foobar", 6));
+}
+
+// Перший кадр — усі стрічки; далі ті самі пікселі — нічого передавати, кадр пропущено
+static void test_identical_strips_skipped() {
+  TEST_ASSERT_EQUAL_UINT32(0xFu, tracker.changed());
+  for (int frame = 0; frame < 10; frame++) TEST_ASSERT_EQUAL_UINT32(0, tracker.changed());
+  memset(leds[2], 0x40, sizeof(leds[2]));
+  tracker.changed();
+  TEST_ASSERT_EQUAL_UINT32(0, tracker.changed()); // той самий новий вміст — знову без змін
+  TEST_ASSERT_EQUAL_UINT32(2, tracker.shown());
+  TEST_ASSERT_EQUAL_UINT32(11, tracker.skipped());
+}
+
+// Один змінений байт одного пікселя — лише біт його стрічки; повернення старого значення — теж зміна
+static void test_single_pixel_change() {
+  tracker.changed();
+  leds[1][PIXELS * 3 - 1] = 1; // синій канал останнього пікселя
+  TEST_ASSERT_EQUAL_UINT32(1u << 1, tracker.changed());
+  TEST_ASSERT_EQUAL_UINT32(0, tracker.changed());
+  leds[1][PIXELS * 3 - 1] = 0;
+  leds[3][0] = 255;
+  TEST_ASSERT_EQUAL_UINT32((1u << 1) | (1u << 3), tracker.changed());
+}
+
+// Після invalidate — усі стрічки, навіть без змін пікселів; attach — лише приєднана стрічка
+static void test_forced_refresh() {
+  tracker.changed();
+  tracker.invalidate();
+  TEST_ASSERT_EQUAL_UINT32(0xFu, tracker.changed());
+  TEST_ASSERT_EQUAL_UINT32(0, tracker.changed());
+  tracker.attach(0, leds[0], sizeof(leds[0]));
+  TEST_ASSERT_EQUAL_UINT32(1u << 0, tracker.changed());
+  TEST_ASSERT_EQUAL_UINT32(0, tracker.changed());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_fnv1a_reference_values);
+  RUN_TEST(test_identical_strips_skipped);
+  RUN_TEST(test_single_pixel_change);
+  RUN_TEST(test_forced_refresh);
+  return UNITY_END();
+}
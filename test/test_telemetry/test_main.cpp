@@ -0,0 +1,71 @@
+// Тести телеметрії: ліміт частоти за фіктивним годинником, потім два потоки — виробник логує, не чекаючи
+// (повна черга — повідомлення відкинуте цілим), споживач перевіряє, що кожне повідомлення прийшло
+// повністю, частини — поспіль і без чужих записів між ними.
+//   pio test -e native -f test_telemetry
+#include "AudioConfig.h"
+#include "Telemetry.h"
+
+#include <unity.h>
+
+#include <atomic>
+#include <thread>
+
+#define STRESS_MESSAGES 200000L
+
+void setUp() {}
+void tearDown() {}
+
+static void test_rate_limit() {
+  TelemetryChannel limits;
+  int allowed = 0;
+  for (uint32_t ms = 0; ms < 60000; ms += 10) allowed += limits.due(TELEMETRY_SIGNAL, ms);
+  TEST_ASSERT_EQUAL_INT(60000 / (int)TelemetryChannel::defaultIntervalMs(TELEMETRY_SIGNAL), allowed);
+}
+
+static TelemetryChannel channel;
+
+static void test_messages_whole_or_dropped() {
+  const int values = SAMPLES + 4; // найдовше повідомлення: кадр зразків і ще кілька значень (17 частин)
+  long errors = 0, delivered = 0;
+  std::atomic<bool> done(false);
+  std::thread producer([&done] {
+    float message[values];
+    for (long m = 0; m < STRESS_MESSAGES; m++) {
+      for (int i = 0; i < values; i++) message[i] = m % 1000 * 1000 + i; // точні у float
+      channel.log(TELEMETRY_SIGNAL, m, message, values);
+      if (m % 16 == 0) std::this_thread::yield(); // даємо споживачу шанс (на одноядерній машині)
+    }
+    done = true;
+  });
+  std::thread consumer([&] {
+    TelemetryRecord r;
+    int nextPart = 0;
+    uint32_t message = 0;
+    while (true) {
+      bool finished = done; // до pop: якщо виробник уже закінчив, а черга порожня — записів більше не буде
+      if (!channel.pop(r)) {
+        if (finished) break;
+        std::this_thread::yield();
+        continue;
+      }
+      if (r.part != nextPart || (r.part > 0 && r.timeMs != message) || r.parts != (values + TELEMETRY_VALUES - 1) / TELEMETRY_VALUES)
+        errors++;
+      message = r.timeMs;
+      for (int i = 0; i < r.count; i++)
+        if (r.values[i] != (float)(message % 1000 * 1000 + r.part * TELEMETRY_VALUES + i)) errors++;
+      nextPart = r.part + 1 == r.parts ? 0 : r.part + 1;
+      if (nextPart == 0) delivered++;
+    }
+  });
+  producer.join();
+  consumer.join();
+  TEST_ASSERT_EQUAL_INT(0, errors);
+  TEST_ASSERT_EQUAL_INT(STRESS_MESSAGES, delivered + (long)channel.dropped());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_rate_limit);
+  RUN_TEST(test_messages_whole_or_dropped);
+  return UNITY_END();
+}
@@ -0,0 +1,121 @@
+// Тести WavFileSource на згенерованому файлі (у репозиторії немає WAV): кадри по SAMPLES і кроки hop
+// різної довжини, складені поспіль, мають дати рівно записані зразки — без пропусків і повторів;
+// у режимі loop після кінця файлу читання продовжується з початку.
+//   pio test -e native -f test_wav_source
+#include "SyntheticSignal.h"
+#include "WavFileSource.h"
+
+#include <unity.h>
+
+#include <algorithm>
+#include <stdint.h>
+#include <stdio.h>
+#include <vector>
+
+static const char *PATH = "test_wav_source.wav";
+static std::vector<int> written; // зразки у файлі (неповний останній кадр)
+
+// Записує зразки у шкалі АЦП як WAV (PCM 16 біт, моно) — назад у 12 біт вони читаються без втрат.
+// Перед "data" — службовий блок непарної довжини: WavFileSource має його пропустити разом із вирівнюванням.
+// fmtSize < 16 — пошкоджений блок формату: записуються лише перші fmtSize байтів
+static bool writeWav(const char *path, const std::vector<int> &samples, uint32_t fmtSize = 16) {
+  FILE *file = fopen(path, "wb");
+  if (!file) return false;
+  auto le = [file](uint32_t value, int bytes) {
+    for (int i = 0; i < bytes; i++) fputc((value >> (8 * i)) & 0xFF, file);
+  };
+  uint32_t dataBytes = samples.size() * 2;
+  fwrite("RIFF", 1, 4, file);
+  le(4 + (8 + fmtSize + (fmtSize & 1)) + (8 + 5 + 1) + (8 + dataBytes), 4);
+  fwrite("WAVE", 1, 4, file);
+  fwrite("fmt ", 1, 4, file);
+  le(fmtSize, 4);
+  const uint8_t fmt[16] = {1, 0, 1, 0, // PCM, моно
+                           SAMPLING_FREQ & 0xFF, (SAMPLING_FREQ >> 8) & 0xFF, 0, 0, (SAMPLING_FREQ * 2) & 0xFF, (SAMPLING_FREQ * 2) >> 8, 0, 0,
+                           2, 0, 16, 0}; // вирівнювання блоку, 16 біт
+  fwrite(fmt, 1, fmtSize, file);
+  if (fmtSize & 1) fputc(0, file);
+  fwrite("LIST", 1, 4, file);
+  le(5, 4);
+  fwrite("test\0", 1, 6, file); // 5 байтів + вирівнювання до парної довжини
+  fwrite("data", 1, 4, file);
+  le(dataBytes, 4);
+  for (int v : samples) le((uint16_t)(int16_t)((v - ADC_MID) * 16), 2);
+  return fclose(file) == 0;
+}
+
+void setUp() {
+  std::vector<int> synth = synthSamples(24);
+  written.assign(synth.begin(), synth.begin() + 20 * SAMPLES + 37);
+  TEST_ASSERT_TRUE(writeWav(PATH, written));
+}
+
+void tearDown() { remove(PATH); }
+
+static void test_header() {
+  WavFileSource source(PATH);
+  TEST_ASSERT_TRUE(source.begin());
+  TEST_ASSERT_EQUAL_UINT32(SAMPLING_FREQ, source.sampleRate());
+  TEST_ASSERT_EQUAL(written.size(), source.totalSamples());
+}
+
+// Кадри по SAMPLES, як їх бере конвеєр, мають збігатися з файлом, прочитаним цілком
+static void test_frames_are_gapless() {
+  WavFileSource source(PATH);
+  TEST_ASSERT_TRUE(source.begin());
+  std::vector<int> frames;
+  int frame[SAMPLES];
+  while (source.read(frame, SAMPLES, 0) == SAMPLES) frames.insert(frames.end(), frame, frame + SAMPLES);
+  TEST_ASSERT_EQUAL(written.size() / SAMPLES * SAMPLES, frames.size());
+  TEST_ASSERT_TRUE(std::equal(frames.begin(), frames.end(), written.begin()));
+}
+
+static void test_hops() {
+  const size_t hops[] = {32, 64, 37, SAMPLES}; // кроки, які бере задача аналізу, і "незручний" 37
+  for (size_t hop : hops) {
+    WavFileSource source(PATH);
+    TEST_ASSERT_TRUE(source.begin());
+    std::vector<int> read, block(hop);
+    size_t got;
+    while ((got = source.read(block.data(), hop, 0)) > 0) read.insert(read.end(), block.begin(), block.begin() + got);
+    TEST_ASSERT_TRUE(read == written);
+    TEST_ASSERT_EQUAL(0, source.available());
+  }
+}
+
+static void test_loop() {
+  WavFileSource looped(PATH, true);
+  TEST_ASSERT_TRUE(looped.begin());
+  std::vector<int> twice(2 * written.size());
+  TEST_ASSERT_EQUAL(twice.size(), looped.read(twice.data(), twice.size(), 0));
+  TEST_ASSERT_TRUE(std::equal(written.begin(), written.end(), twice.begin()));
+  TEST_ASSERT_TRUE(std::equal(written.begin(), written.end(), twice.begin() + written.size()));
+}
+
+static void test_missing_file() {
+  WavFileSource source("test_wav_source_missing.wav");
+  TEST_ASSERT_FALSE(source.begin());
+}
+
+// Блок "fmt " коротший за 16 байтів відхиляється: розрядність у ньому обрізана, а пропуск решти блоку
+// (size - 16) став би від’ємним. 15 байтів + вирівнювання — без перевірки розрядність читалась би з байта вирівнювання
+static void test_short_fmt_chunk() {
+  static const uint32_t sizes[] = {14, 15};
+  for (uint32_t size : sizes) {
+    TEST_ASSERT_TRUE(writeWav(PATH, written, size));
+    WavFileSource source(PATH);
+    TEST_ASSERT_FALSE(source.begin());
+    TEST_ASSERT_EQUAL(0, source.available());
+  }
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_header);
+  RUN_TEST(test_frames_are_gapless);
+  RUN_TEST(test_hops);
+  RUN_TEST(test_loop);
+  RUN_TEST(test_missing_file);
+  RUN_TEST(test_short_fmt_chunk);
+  return UNITY_END();
+}
@@ -0,0 +1,52 @@
+# embed_ui.py — вбудовує index.html у прошивку: стискає gzip і записує include/index_html_gz.h
+# (масив байтів у флеш-пам’яті і ETag — хеш вмісту). Запускається PlatformIO перед збіркою
+# (extra_scripts у platformio.ini), а також вручну: python tools/embed_ui.py
+# Файл генерується і не зберігається в git; переписується, лише коли змінилась сторінка.
+import gzip
+import hashlib
+import os
+
+try:
+    Import("env")  # noqa: F821 — визначено, коли скрипт запускає PlatformIO (SCons)
+    PROJECT_DIR = env.subst("$PROJECT_DIR")  # noqa: F821
+except NameError:
+    PROJECT_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+SOURCE = os.path.join(PROJECT_DIR, "index.html")
+TARGET = os.path.join(PROJECT_DIR, "include", "index_html_gz.h")
+
+
+def render(html):
+    packed = gzip.compress(html, compresslevel=9, mtime=0)  # mtime=0 — однаковий результат для однакової сторінки
+    etag = hashlib.sha1(html).hexdigest()[:16]
+    lines = []
+    for i in range(0, len(packed), 16):
+        lines.append("  " + ", ".join("0x%02x" % b for b in packed[i : i + 16]) + ",")
+    return (
+        "// Згенеровано tools/embed_ui.py з index.html — не редагувати вручну\n"
+        "#ifndef INDEX_HTML_GZ_H\n"
+        "#define INDEX_HTML_GZ_H\n\n"
+        "#include <pgmspace.h>\n"
+        "#include <stddef.h>\n"
+        "#include <stdint.h>\n\n"
+        "#define INDEX_HTML_ETAG \"\\\"%s\\\"\" // ETag: хеш нестисненої сторінки\n"
+        "#define INDEX_HTML_SIZE %d // байтів до стиснення\n\n"
+        "const size_t INDEX_HTML_GZ_SIZE = %d;\n"
+        "const uint8_t INDEX_HTML_GZ[] PROGMEM = {\n%s\n};\n\n"
+        "#endif\n" % (etag, len(html), len(packed), "\n".join(lines))
+    )
+
+
+def main():
+    with open(SOURCE, "rb") as f:
+        header = render(f.read())
+    if os.path.exists(TARGET):
+        with open(TARGET, "r", encoding="utf-8") as f:
+            if f.read() == header:
+                return
+    with open(TARGET, "w", encoding="utf-8") as f:
+        f.write(header)
+    print("embed_ui: %s -> %s" % (os.path.relpath(SOURCE, PROJECT_DIR), os.path.relpath(TARGET, PROJECT_DIR)))
+
+
+main()
@@ -0,0 +1,44 @@
+# size_report.py — звіт про статичну пам’ять прошивки після збірки: найбільші об’єкти .bss/.data
+# (зокрема pipeline — конвеєр разом з ареною DSP-буферів DspArena) за таблицею символів ELF (nm).
+# Запускається PlatformIO після лінкування (extra_scripts у platformio.ini), а також вручну:
+#   python tools/size_report.py .pio/build/esp32dev/firmware.elf [xtensa-esp32-elf-nm]
+import subprocess
+import sys
+
+TOP = 12  # скільки найбільших об’єктів друкувати
+WATCH = ("pipeline",)  # друкуються завжди, навіть якщо не потрапили в TOP
+
+
+def static_symbols(elf, nm):
+    out = subprocess.run([nm, "-S", "-C", "--size-sort", elf], capture_output=True, text=True, check=True).stdout
+    symbols = []
+    for line in out.splitlines():
+        parts = line.split(None, 3)  # адреса, розмір, тип, ім’я
+        if len(parts) == 4 and parts[2] in "bBdD":  # .bss і .data (ОЗП); флеш-таблиці (r/R) не рахуємо
+            symbols.append((int(parts[1], 16), parts[3]))
+    symbols.sort(reverse=True)
+    return symbols
+
+
+def report(elf, nm):
+    symbols = static_symbols(elf, nm)
+    total = sum(size for size, _ in symbols)
+    print("size_report: статична пам’ять (.bss + .data) — %d байтів, найбільші об’єкти:" % total)
+    shown = symbols[:TOP] + [s for s in symbols[TOP:] if s[1] in WATCH]
+    for size, name in shown:
+        print("  %8d  %s" % (size, name))
+
+
+try:
+    Import("env")  # noqa: F821 — визначено, коли скрипт запускає PlatformIO (SCons)
+
+    def after_link(source, target, env):
+        cc = env.subst("$CC")  # xtensa-esp32-elf-gcc -> xtensa-esp32-elf-nm
+        report(str(target[0]), cc[: -len("gcc")] + "nm" if cc.endswith("gcc") else "nm")
+
+    env.AddPostAction("$BUILD_DIR/${PROGNAME}.elf", after_link)  # noqa: F821
+except NameError:
+    if __name__ == "__main__":
+        if len(sys.argv) < 2:
+            sys.exit("використання: python tools/size_report.py firmware.elf [nm]")
+        report(sys.argv[1], sys.argv[2] if len(sys.argv) > 2 else "nm")